@@ -25,16 +25,23 @@ extern "C" {
 
 /* GUI component library */
 #include "system.h"
+#include "region.h"
 #include "color.h"
 #include "driver.h"
 #include "dc.h"
+#include "gradient.h"
+#include "image.h"
 #include "font.h"
 #include "widget.h"
 #include "title.h"
+#include "scroll.h"
+#include "list.h"
+#include "terminal.h"
 #include "window.h"
 #include "event.h"
 #include "app.h"
 #include "server.h"
+#include "render.h"
 #include "mouse.h"
 #include "kbddef.h"
 
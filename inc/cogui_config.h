@@ -23,6 +23,18 @@ extern "C" {
 /* 0 for hardware engine, 1 for buffer engine */
 #define COGUI_SCREEN_TYPE       0
 
+/* frames painted per second at most, 0 to paint right after every change */
+#define COGUI_FRAME_RATE        30
+
+/* how many rectangles a clip region can hold */
+#define COGUI_REGION_MAX_RECTS  32
+
+/* unpacked anti-aliased glyphs kept, 1 at least */
+#define COGUI_GLYPH_CACHE_SIZE  8
+
+/* largest zlib window of PNG can be drawn, 256 to 32768 bytes */
+#define COGUI_PNG_MAX_WINDOW    32768
+
 /* debug output (serial) */
 #define COGUI_DEBUG_PRINT
 
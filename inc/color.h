@@ -71,6 +71,11 @@ extern const color_t dark_grey;
 extern const color_t white;
 extern const color_t black;
 
+/* color function */
+color_t gui_color_blend(color_t fg, color_t bg, uint8_t alpha);
+uint32_t gui_color_to_argb8888(color_t c);
+color_t gui_color_from_argb8888(uint32_t argb);
+
 #ifdef __cplusplus
 }
 #endif
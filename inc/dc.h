@@ -24,6 +24,8 @@ extern "C" {
 #define GUI_DC_TA(dc)         (gui_dc_get_gc(GUI_DC(dc))->text_align)         /**< get text_align     */
 #define GUI_DC_FONT(dc)       (gui_dc_get_gc(GUI_DC(dc))->font)               /**< get font pointer   */
 #define GUI_DC_PADDING(dc)    (gui_dc_get_gc(GUI_DC(dc))->padding)            /**< get font pointer   */
+#define GUI_DC_ALPHA(dc)      (gui_dc_get_gc(GUI_DC(dc))->alpha)              /**< get alpha          */
+#define GUI_DC_BLEND(dc)      (gui_dc_get_gc(GUI_DC(dc))->blend)              /**< get blend mode     */
 
 /* border style */
 #define GUI_BORDER_NONE       0x00         /**< border style none      */
@@ -31,6 +33,10 @@ extern "C" {
 
 #define GUI_BORDER_DEFAULT_WIDTH  2        /**< default border width   */
 
+/* polygon fill rule */
+#define GUI_FILL_EVEN_ODD     0x00         /**< inside if crossed odd times  */
+#define GUI_FILL_NON_ZERO     0x01         /**< inside if winding not zero   */
+
 extern const color_t default_foreground;
 
 struct dc;
@@ -48,6 +54,13 @@ typedef struct dc dc_t;
 #define GUI_TEXT_ALIGN_MIDDLE         0x10        /**< vertical align to middle       */
 #define GUI_TEXT_ALIGN_BOTTOM         0x20        /**< vertical align to bottom       */
 
+/* text style */
+#define GUI_TEXT_OPAQUE               0x40        /**< glyph cells filled by background */
+
+/* blend mode */
+#define GUI_BLEND_NONE                0x00        /**< pixels are overwritten         */
+#define GUI_BLEND_ALPHA               0x01        /**< pixels are blended by alpha    */
+
 /**
  * @struct   cogui_gc dc.h	
  * @brief    Graph context struct
@@ -62,6 +75,9 @@ struct gc
 
     uint16_t         text_align;             /**< text alignment                 */
     uint64_t         padding;                /**< rectangle padding (for text)   */
+
+    uint8_t          alpha;                  /**< 255 for opaque, 0 for clear    */
+    uint8_t          blend;                  /**< blend mode of all drawing      */
 };
 
 #define GUI_PADDING(top, bottom, left, right) ((uint64_t)(((top)<<24)|((bottom)<<16)|((left)<<8)|(right)))
@@ -85,6 +101,13 @@ struct dc_engine
     void (*draw_vline)(dc_t *dc, int32_t x, int32_t y1, int32_t y2);
     void (*draw_hline)(dc_t *dc, int32_t x1, int32_t x2, int32_t y);
     void (*fill_rect)(dc_t *dc, rect_t *rect);
+    void (*copy_area)(dc_t *dc, rect_t *rect, int32_t dx, int32_t dy);
+    void (*draw_glyph)(dc_t *dc, int32_t x, int32_t y, int32_t left, int32_t width,
+                       int32_t height, const uint16_t *bits, bool_t opaque);
+    void (*draw_indexed)(dc_t *dc, int32_t x, int32_t y, int32_t width, int32_t height,
+                         const uint8_t *index, const color_t *palette, int32_t key);
+    void (*draw_pixels)(dc_t *dc, int32_t x, int32_t y, int32_t width,
+                        const void *pixels, int32_t count);
 
     StatusType (*fini)(dc_t * dc);
 };
@@ -111,6 +134,8 @@ struct dc_hw_t
 
     struct widget         *owner;         /**< DC owner widget    */
     struct graphic_driver *hw_driver;     /**< hardware driver    */
+
+    struct rect           clip;           /**< physical clip rect */
 };
 
 /**
@@ -139,6 +164,8 @@ struct dc_buffer_t
 dc_t *dc_hw_create(struct widget *owner);
 
 void gui_dc_draw_line(dc_t *dc, int32_t x1, int32_t x2, int32_t y1, int32_t y2);
+void gui_dc_draw_wide_line(dc_t *dc, int32_t x1, int32_t x2, int32_t y1, int32_t y2, int32_t width);
+void gui_dc_draw_line_aa(dc_t *dc, int32_t x1, int32_t x2, int32_t y1, int32_t y2);
 void gui_dc_draw_rect(dc_t *dc, rect_t *rect);
 void gui_dc_draw_shaded_rect(dc_t *dc, rect_t *rect, color_t c1, color_t c2);
 void gui_dc_fill_rect_forecolor(dc_t *dc, rect_t *rect);
@@ -148,11 +175,31 @@ void gui_dc_draw_vertical_line(dc_t *dc, int32_t x, int32_t y1, int32_t y2);
 
 void gui_dc_draw_border(dc_t *dc, rect_t *rect);
 
+/* round shapes, drawn and filled with foreground color */
+void gui_dc_draw_circle(dc_t *dc, int32_t x, int32_t y, int32_t r);
+void gui_dc_fill_circle(dc_t *dc, int32_t x, int32_t y, int32_t r);
+void gui_dc_draw_ellipse(dc_t *dc, int32_t x, int32_t y, int32_t rx, int32_t ry);
+void gui_dc_fill_ellipse(dc_t *dc, int32_t x, int32_t y, int32_t rx, int32_t ry);
+void gui_dc_draw_round_rect(dc_t *dc, rect_t *rect, int32_t r);
+void gui_dc_fill_round_rect(dc_t *dc, rect_t *rect, int32_t r);
+
+/* polygons, vertices in logic coordinate */
+StatusType gui_dc_fill_polygon(dc_t *dc, const point_t *points, int32_t count, uint8_t rule);
+void gui_dc_draw_polyline(dc_t *dc, const point_t *points, int32_t count);
+
 void gui_dc_draw_text(dc_t *dc, rect_t *rect, char *str);
+void gui_dc_get_text_origin(dc_t *dc, rect_t *rect, char *str, point_t *origin);
+
+/* move pixels of a logic rectangle by (dx, dy) */
+void gui_dc_copy_area(dc_t *dc, rect_t *rect, int32_t dx, int32_t dy);
 
 /* get current graph context */
 struct gc *gui_dc_get_gc(dc_t *dc);
 
+/* limit drawing to a physical rectangle, Co_NULL to reset */
+void gui_dc_set_clip(dc_t *dc, rect_t *rect);
+void gui_dc_get_bound(dc_t *dc, rect_t *bound);
+
 struct widget *gui_dc_get_owner(dc_t *dc);
 
 /* DC usage function */
@@ -41,6 +41,15 @@ struct graphic_driver_ops
 
     void (*draw_hline)(color_t *c, int32_t x1, int32_t x2, int32_t y);
     void (*draw_vline)(color_t *c, int32_t x , int32_t y1, int32_t y2);
+
+    /* move pixels of rect by (dx, dy), optional (e.g. by DMA) */
+    void (*copy_area)(rect_t *rect, int32_t dx, int32_t dy);
+
+    /* blend c onto pixels from x1 to x2 by alpha, optional */
+    void (*blend_hline)(color_t *c, uint8_t alpha, int32_t x1, int32_t x2, int32_t y);
+
+    /* copy pixels in format of framebuffer to x1 .. x2, repeated every count pixels, optional */
+    void (*blit_line)(const void *pixels, int32_t count, int32_t x1, int32_t x2, int32_t y);
 };
 
 /* graphic extension operations */
@@ -59,6 +68,16 @@ struct graphic_ext_ops
     void (*fill_ellipse)(color_t *c, int32_t x, int32_t y, int32_t rx, int32_t ry);
 };
 
+/* graphic panel operations */
+struct graphic_panel_ops
+{
+    /* handler is called in vsync (TE) interrupt of panel */
+    void (*set_vsync_handler)(void (*handler)(void));
+
+    /* show another framebuffer on panel (page flip) */
+    void (*set_frame_buffer)(uint32_t frame_buffer);
+};
+
 struct graphic_driver
 {
     /* pixel format and byte per pixel */
@@ -69,16 +88,38 @@ struct graphic_driver
     uint16_t height;
 
     /* framebuffer address and ops */
-    uint32_t frame_buffer;
+    uint32_t frame_buffer;      /* buffer to draw, back buffer if double buffered */
+    uint32_t front_buffer;      /* buffer on panel, 0 if single buffered          */
+    uint16_t pitch;             /* bytes per line, 0 for width*2                  */
+    rect_t   back_dirty;        /* area back buffer is older than front buffer    */
 
     const struct graphic_driver_ops *ops;
     const struct graphic_ext_ops *ext_ops;
+    const struct graphic_panel_ops *panel_ops;
 };
 typedef struct graphic_driver graphic_driver_t;
 
+/* bytes per pixel and bytes per line of framebuffer */
+#define GUI_FB_BPP(d)       ((d)->pixel_format == GRAPHIC_PIXEL_FORMAT_ARGB888 ? 4 : 2)
+#define GUI_FB_PITCH(d)     ((d)->pitch ? (d)->pitch : (d)->width*GUI_FB_BPP(d))
+
+extern const struct graphic_driver_ops gui_framebuffer_rgb565_ops;
+extern const struct graphic_driver_ops gui_framebuffer_argb8888_ops;
+
+const struct graphic_driver_ops *gui_framebuffer_get_ops(uint8_t pixel_format);
+
 graphic_driver_t *gui_graphic_driver_get_default(void);
 void gui_set_graphic_driver(graphic_driver_t *driver);
 
+/* double buffering */
+StatusType gui_graphic_driver_set_double_buffer(graphic_driver_t *driver, uint32_t back_buffer);
+void gui_graphic_driver_begin_frame(graphic_driver_t *driver);
+void gui_graphic_driver_end_frame(graphic_driver_t *driver, rect_t *damage);
+
+void gui_framebuffer_copy_rect(graphic_driver_t *driver, uint32_t dst, uint32_t src, rect_t *rect);
+void gui_framebuffer_blit(graphic_driver_t *dst, graphic_driver_t *src, rect_t *rect);
+void gui_framebuffer_move_rect(graphic_driver_t *driver, rect_t *rect, int32_t dx, int32_t dy);
+
 #ifdef __cplusplus
 }
 #endif
@@ -14,16 +14,104 @@
 extern "C" {
 #endif
 
+/**
+ * @struct   font_glyph font.h
+ * @brief    Glyph metric struct
+ * @details  Bitmap columns from left to left+width of a glyph are drawn on
+ *           pen position, then pen moves by advance.
+ */
+struct font_glyph {
+    uint8_t                  left;       /**< First bitmap column drawn      */
+    uint8_t                  width;      /**< Bitmap columns drawn           */
+    uint8_t                  advance;    /**< Pen movement after glyph       */
+};
+
+/**
+ * @struct   font_kern font.h
+ * @brief    Kerning pair struct
+ * @details  Pairs of a font are sorted by pair, so they can be searched.
+ */
+struct font_kern {
+    uint16_t                 pair;       /**< Left and right character       */
+    int8_t                   adjust;     /**< Pen movement added between     */
+};
+
+#define GUI_FONT_KERN_PAIR(l, r)    ((uint16_t)(((uint8_t)(l) << 8) | (uint8_t)(r)))
+
+/**
+ * @struct   font_range font.h
+ * @brief    Codepoint range struct
+ * @details  Codepoints from first to first+count-1 use glyphs from glyph to
+ *           glyph+count-1. Ranges of a font are sorted and not overlapped.
+ */
+struct font_range {
+    uint32_t                 first;      /**< First codepoint of range       */
+    uint16_t                 count;      /**< Codepoints in range            */
+    uint16_t                 glyph;      /**< Glyph of first codepoint       */
+};
+
+/** glyph bitmap is run length coded */
+#define GUI_GLYPH_RLE               0x01
+
+/** no glyph for codepoint */
+#define GUI_GLYPH_NONE              0xFFFF
+
+/** tallest font can be drawn */
+#define GUI_FONT_MAX_HEIGHT         32
+
+/** codepoint of bad utf-8 sequence */
+#define GUI_UTF8_INVALID            0xFFFD
+
+/**
+ * @struct   font_packed_glyph font.h
+ * @brief    Packed glyph struct
+ * @details  Bitmap of a glyph is width x height bits, row by row without
+ *           padding, highest bit first. With GUI_GLYPH_RLE it is runs of one
+ *           byte instead, highest bit is the pixel and the low 7 bits are
+ *           run length minus 1. Anti-aliased font takes bpp bits a pixel the
+ *           same way, value is coverage from none to full, and has no runs.
+ */
+struct font_packed_glyph {
+    uint32_t                 offset;     /**< First byte in font bitmap      */
+    uint8_t                  width;      /**< Bitmap columns, 16 at most     */
+    uint8_t                  advance;    /**< Pen movement after glyph       */
+    uint8_t                  flag;       /**< GUI_GLYPH_RLE or 0             */
+};
+
+/**
+ * @struct   font_packed font.h
+ * @brief    Packed font struct
+ * @details  Glyph of a codepoint is searched in sorted ranges, so sparse
+ *           sets like accented latin or part of CJK need no dense table.
+ */
+struct font_packed {
+    const struct font_range *       ranges;     /**< Sorted codepoint ranges */
+    uint16_t                        range_cnt;  /**< How many ranges         */
+    uint16_t                        missing;    /**< Glyph of unknown one    */
+    const struct font_packed_glyph *glyphs;     /**< Glyph table             */
+    const uint8_t *                 bitmap;     /**< Bitmaps of all glyphs   */
+    uint8_t                         bpp;        /**< 2 or 4 if anti-aliased  */
+};
+
+/** every glyph is font width */
+#define GUI_FONT_IS_MONO(f)         ((f)->glyphs == Co_NULL && (f)->packed == Co_NULL)
+
 /**
  * @struct   cogui_font
  * @brief    font struct
- * @details  This struct is font contains some information.
+ * @details  This struct is font contains some information. Font without
+ *           glyph metrics is monospace, every glyph is width wide. Font
+ *           with packed glyphs takes utf-8 text and has no data table.
  */
 struct font {
     char *                   family;     /**< Which font family belongs to   */
     uint16_t                 width;      /**< Font width                     */
     uint16_t                 height;     /**< Font height                    */
     const uint16_t *         data;       /**< Real font table pointer        */
+    const struct font_glyph *glyphs;     /**< Glyph metrics, Co_NULL if mono */
+    const struct font_kern * kerning;    /**< Kerning pairs, can be Co_NULL  */
+    uint16_t                 kern_cnt;   /**< How many kerning pairs         */
+    const struct font_packed *packed;    /**< Packed glyphs, can be Co_NULL  */
 };
 typedef struct font font_t;
 
@@ -31,13 +119,22 @@ typedef struct font font_t;
 extern font_t tm_font_7x10;
 extern font_t tm_font_11x18;
 extern font_t tm_font_16x26;
+extern font_t tm_font_11x18_prop;
 
 /* extern from symbol.c */
 extern font_t tm_symbol_16x16;
 
 /* display text function */
 void gui_lcd_puts(uint16_t x, uint16_t y, char *str, font_t *font, dc_t *dc, rect_t *rect);
-void gui_lcd_putc(uint16_t x, uint16_t y, char c, font_t *font, dc_t *dc, rect_t *rect);
+void gui_lcd_putc(uint16_t x, uint16_t y, uint32_t c, font_t *font, dc_t *dc, rect_t *rect);
+
+/* get glyph attributes */
+uint16_t gui_font_find_glyph(font_t *font, uint32_t c);
+uint16_t gui_font_get_advance(font_t *font, uint32_t c);
+int16_t gui_font_get_kerning(font_t *font, uint32_t left, uint32_t right);
+
+/* decode text */
+uint32_t gui_utf8_next(const char **str);
 
 /* get text attributes */
 uint32_t gui_get_text_width(char *str, font_t *font);
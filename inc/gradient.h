@@ -0,0 +1,66 @@
+/**
+ *******************************************************************************
+ * @file       gradient.h
+ * @version    V0.7.4
+ * @date       2020.04.18
+ * @brief      Gradient fill header file.
+ *******************************************************************************
+ */
+
+#ifndef __GUI_GRADIENT_H__
+#define __GUI_GRADIENT_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* gradient direction */
+#define GUI_GRADIENT_VERTICAL     0x00      /**< color changes from top to bottom */
+#define GUI_GRADIENT_HORIZONTAL   0x01      /**< color changes from left to right */
+
+/* ordered dither matrix size */
+#define GUI_DITHER_SIZE           4
+
+/**
+ * @struct   gradient_stop gradient.h
+ * @brief    Gradient color stop struct
+ * @details  This struct is a color at a place of gradient, 0 for start and
+ *           255 for end.
+ */
+struct gradient_stop
+{
+    uint8_t   pos;                  /**< place along gradient, 0 to 255    */
+    color_t   color;                /**< color at this place               */
+};
+
+/**
+ * @struct   gradient gradient.h
+ * @brief    Gradient struct
+ * @details  This struct keeps rows of a gradient in pixel format of screen,
+ *           made once and copied line by line on every fill. Vertical
+ *           gradient keeps one dither period a line, which is repeated
+ *           across rectangle. Horizontal gradient keeps one row a dither
+ *           line.
+ */
+struct gradient
+{
+    uint8_t   direction;            /**< GUI_GRADIENT_VERTICAL/HORIZONTAL  */
+    uint8_t   bpp;                  /**< bytes a pixel                     */
+    int16_t   length;               /**< pixels along gradient             */
+    int16_t   rows;                 /**< rows kept                         */
+    int16_t   span;                 /**< pixels a row                      */
+    uint8_t   *pixels;              /**< rows, one after another           */
+};
+typedef struct gradient gradient_t;
+
+gradient_t *gui_gradient_create(uint8_t direction, int32_t length,
+                                const struct gradient_stop *stops, int32_t count);
+void gui_gradient_delete(gradient_t *gradient);
+
+void gui_dc_fill_gradient(dc_t *dc, rect_t *rect, gradient_t *gradient);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __GUI_GRADIENT_H__ */
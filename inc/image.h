@@ -0,0 +1,91 @@
+/**
+ *******************************************************************************
+ * @file       image.h
+ * @version    V0.7.4
+ * @date       2020.04.18
+ * @brief      Image drawing header file.
+ *******************************************************************************
+ */
+
+#ifndef __GUI_IMAGE_H__
+#define __GUI_IMAGE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* pixel format of image */
+#define GUI_IMAGE_RGB565          0x00      /**< 2 bytes a pixel                    */
+#define GUI_IMAGE_ARGB8888        0x01      /**< 4 bytes a pixel, alpha is not used */
+#define GUI_IMAGE_INDEX1          0x02      /**< 1 bit palette index a pixel        */
+#define GUI_IMAGE_INDEX4          0x03      /**< 4 bits palette index a pixel       */
+#define GUI_IMAGE_INDEX8          0x04      /**< 8 bits palette index a pixel       */
+#define GUI_IMAGE_QOI             0x05      /**< QOI file, decoded while drawing    */
+#define GUI_IMAGE_PNG             0x06      /**< PNG file, decoded while drawing    */
+
+/* image flag */
+#define GUI_IMAGE_RLE             0x01      /**< data is run length coded           */
+#define GUI_IMAGE_KEY             0x02      /**< pixels equal to key are not drawn  */
+
+/* pixels decoded at a time while drawing */
+#define GUI_IMAGE_CHUNK           32
+
+/* filter of scaled image */
+#define GUI_IMAGE_NEAREST         0x00      /**< nearest pixel, fast                */
+#define GUI_IMAGE_BILINEAR        0x01      /**< mix of 4 nearest pixels, smooth    */
+
+#define GUI_IMAGE_IS_INDEXED(i)   ((i)->format >= GUI_IMAGE_INDEX1 && (i)->format <= GUI_IMAGE_INDEX8)
+#define GUI_IMAGE_IS_FILE(i)      ((i)->format >= GUI_IMAGE_QOI)
+
+/* big endian word of file header */
+#define GUI_IMAGE_BE32(p)         (((uint32_t)(p)[0] << 24) | ((uint32_t)(p)[1] << 16) | \
+                                   ((uint32_t)(p)[2] << 8) | (uint32_t)(p)[3])
+
+/**
+ * @struct   image image.h
+ * @brief    Image struct
+ * @details  Pixels are kept row by row from top. Palette index is packed
+ *           highest bit first and each row starts on a new byte. Pixel is
+ *           in byte order of CPU and data of pixel format is aligned to it.
+ *
+ *           With GUI_IMAGE_RLE data is runs going on across rows instead.
+ *           Each run starts with a byte, the low 7 bits are pixels minus 1.
+ *           If highest bit is set, one pixel follows and is repeated, or
+ *           else that many pixels follow. An index takes a whole byte in
+ *           runs whatever format is.
+ *
+ *           QOI and PNG image is the whole file. It is decoded from start
+ *           on every drawing, a few rows kept at a time, and pixels less
+ *           than half opaque are not drawn.
+ */
+struct image
+{
+    uint8_t           format;       /**< GUI_IMAGE_RGB565 and so on        */
+    uint8_t           flag;         /**< GUI_IMAGE_RLE, GUI_IMAGE_KEY      */
+    uint16_t          width;        /**< pixels a row                      */
+    uint16_t          height;       /**< rows                              */
+    uint32_t          key;          /**< index or pixel not drawn          */
+    const color_t *   palette;      /**< color of index, Co_NULL if pixels */
+    const uint8_t *   data;         /**< pixels, runs or file              */
+    uint32_t          size;         /**< bytes of file, 0 for others       */
+};
+typedef struct image image_t;
+
+StatusType gui_image_load(image_t *image, const uint8_t *data, uint32_t size);
+StatusType gui_dc_draw_image(dc_t *dc, int32_t x, int32_t y, const image_t *image);
+StatusType gui_dc_draw_image_scaled(dc_t *dc, rect_t *rect, const image_t *image, uint8_t filter);
+
+/* for image decoders */
+void gui_image_put_pixels(dc_t *dc, int32_t x, int32_t y, const image_t *image,
+                          const uint8_t *units, int32_t n);
+StatusType gui_image_draw_qoi(dc_t *dc, int32_t x, int32_t y, const image_t *image, rect_t *bound);
+StatusType gui_image_draw_png(dc_t *dc, int32_t x, int32_t y, const image_t *image, rect_t *bound);
+
+/* extern from app_icons.c */
+extern const image_t gui_app_icons[];
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __GUI_IMAGE_H__ */
@@ -0,0 +1,55 @@
+/**
+ ********************************************************************************
+ * @file       list.h
+ * @version    V0.7.4
+ * @date       2020.04.18
+ * @brief      List view widget header file.
+ *******************************************************************************
+ */
+
+#ifndef __GUI_LIST_H__
+#define __GUI_LIST_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct window;
+
+/** fill a row slot with content of item index */
+typedef void (*list_render_ptr)(widget_t *list, widget_t *row, int32_t index);
+
+/**
+ * @struct   list_view list.h
+ * @brief    List view struct
+ * @details  This struct is kept in user data of list view widget. Only the
+ *           rows on screen own a widget, slots are reused while scrolling,
+ *           so memory and painting do not grow with item count.
+ */
+struct list_view
+{
+    scroll_view_t    view;                           /**< scroll view data, horizontal only      */
+    int32_t          count;                          /**< how many items in list                 */
+    int32_t          offset;                         /**< vertical pixel offset of content       */
+    int16_t          row_height;                     /**< height of every row                    */
+    int16_t          slot_cnt;                       /**< how many row slots                     */
+    widget_t **      slots;                          /**< row slots, item i is on slot i%cnt     */
+    int32_t *        slot_index;                     /**< item shown by each slot, -1 for none   */
+    list_render_ptr  render;                         /**< fill slot with content of an item      */
+};
+typedef struct list_view list_view_t;
+
+widget_t *gui_list_view_create(struct window *top, rect_t *rect, int32_t row_height, list_render_ptr render);
+
+void gui_list_view_set_count(widget_t *list, int32_t count);
+void gui_list_view_update_item(widget_t *list, int32_t index);
+int32_t gui_list_view_get_index(widget_t *list, widget_t *row);
+
+StatusType gui_list_view_scroll(widget_t *list, int32_t dy);
+StatusType gui_list_view_scroll_to(widget_t *list, int32_t index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __GUI_LIST_H__ */
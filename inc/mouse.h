@@ -25,19 +25,32 @@ extern "C" {
     }                           \
 }                               \
 
+#define GUI_CURSOR_SIZE           16
+
+/**
+ * @struct   cursor mouse.h
+ * @brief    Cursor struct
+ * @details  Cursor is an overlay, it is composited into framebuffer when a
+ *           frame is shown and taken away before next frame is drawn.
+ */
 struct cursor
 {
     uint16_t cx, cy;
     uint8_t speed;
+    bool_t shown;                                   /**< cursor is visible              */
 
-    widget_t *cursor_widget;
+    const uint16_t *border;                         /**< cursor border bitmap           */
+    const uint16_t *inner;                          /**< cursor inner bitmap            */
 
-    uint32_t frame_buffer;
-    color_t save_picture[16][16]; 
+    rect_t drawn;                                   /**< area cursor is composited      */
+    rect_t removed;                                 /**< area cursor is taken away from */
+    uint32_t save_picture[GUI_CURSOR_SIZE][GUI_CURSOR_SIZE];   /**< pixels under cursor, any format */
 };
 typedef struct cursor cursor_t;
 
-void gui_mouse_return_picture(void);
+/* overlay compositing, called around every frame */
+void gui_mouse_overlay_remove(void);
+void gui_mouse_overlay_draw(rect_t *damage);
 
 void gui_mouse_set_position(uint16_t x, uint16_t y);
 void gui_mouse_set_speed(uint8_t speed);
@@ -46,8 +59,8 @@ void gui_mouse_move_delta(int32_t dx,int32_t dy);
 
 void gui_mouse_get_position(point_t *pt);
 
-void gui_mouse_restore(void);
 void gui_mouse_show(void);
+void gui_mouse_hide(void);
 
 #ifdef __cplusplus
 }
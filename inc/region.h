@@ -0,0 +1,56 @@
+/**
+ *******************************************************************************
+ * @file       region.h
+ * @version    V0.7.4
+ * @date       2020.04.18
+ * @brief      Rectangle and region function header file.
+ *******************************************************************************
+ */
+
+#ifndef __GUI_REGION_H__
+#define __GUI_REGION_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** rectangle has no pixel inside */
+#define GUI_RECT_IS_EMPTY(r)      ((r)->x1 >= (r)->x2 || (r)->y1 >= (r)->y2)
+
+/** pixels inside rectangle */
+#define GUI_RECT_AREA(r)          ((uint32_t)GUI_RECT_WIDTH(r) * (uint32_t)GUI_RECT_HEIGHT(r))
+
+/** point (x, y) is inside rectangle */
+#define GUI_RECT_CONTAINS(r, x, y)  \
+    ((x) >= (r)->x1 && (x) < (r)->x2 && (y) >= (r)->y1 && (y) < (r)->y2)
+
+/**
+ * @struct   region region.h
+ * @brief    Region struct
+ * @details  This struct records a region as a set of non-overlapping
+ *           rectangles. The capacity is fixed, so the region is kept on stack.
+ */
+struct region
+{
+    int16_t count;                                  /**< rectangles in use      */
+    rect_t  rects[COGUI_REGION_MAX_RECTS];          /**< rectangles of region   */
+};
+typedef struct region region_t;
+
+/* rectangle function */
+bool_t gui_rect_intersect(const rect_t *r1, const rect_t *r2, rect_t *result);
+void gui_rect_union(const rect_t *r1, const rect_t *r2, rect_t *result);
+bool_t gui_rect_is_intersect(const rect_t *r1, const rect_t *r2);
+int16_t gui_rect_subtract(const rect_t *r, const rect_t *rect, rect_t piece[4]);
+
+/* region function */
+void gui_region_init(region_t *region, const rect_t *rect);
+void gui_region_add_rect(region_t *region, const rect_t *rect);
+void gui_region_subtract_rect(region_t *region, const rect_t *rect);
+bool_t gui_region_is_empty(region_t *region);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __GUI_REGION_H__ */
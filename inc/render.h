@@ -0,0 +1,34 @@
+/**
+ *******************************************************************************
+ * @file       render.h
+ * @version    V0.7.4
+ * @date       2020.04.18
+ * @brief      The frame scheduler for gui engine.
+ *******************************************************************************
+ */
+
+#ifndef __GUI_RENDER_H__
+#define __GUI_RENDER_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* create render task */
+void gui_render_init(void);
+
+/* ask render task to paint damaged area in next frame */
+StatusType gui_render_request(void);
+
+/* called by panel driver on vsync (TE) interrupt */
+void gui_render_vsync(void);
+
+/* keep render task away while changing widgets */
+void gui_render_lock(void);
+void gui_render_unlock(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __GUI_RENDER_H__ */
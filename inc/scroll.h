@@ -0,0 +1,43 @@
+/**
+ ********************************************************************************
+ * @file       scroll.h
+ * @version    V0.7.4
+ * @date       2020.04.18
+ * @brief      Scroll view widget header file.
+ *******************************************************************************
+ */
+
+#ifndef __GUI_SCROLL_H__
+#define __GUI_SCROLL_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct   scroll_view scroll.h
+ * @brief    Scroll view struct
+ * @details  This struct is kept in user data of scroll view widget. Widgets
+ *           built on scroll view put it at the head of their own data.
+ */
+struct scroll_view
+{
+    int16_t          content_width;                  /**< width of content, 0 for no limit       */
+    int16_t          content_height;                 /**< height of content, 0 for no limit      */
+};
+typedef struct scroll_view scroll_view_t;
+
+struct window;
+
+widget_t *gui_scroll_view_create(struct window *top);
+
+void gui_scroll_view_set_content_size(widget_t *view, int32_t width, int32_t height);
+StatusType gui_scroll_view_scroll(widget_t *view, int32_t dx, int32_t dy);
+StatusType gui_scroll_view_scroll_to(widget_t *view, int32_t x, int32_t y);
+void gui_scroll_view_get_offset(widget_t *view, point_t *offset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __GUI_SCROLL_H__ */
@@ -25,6 +25,8 @@ typedef signed   char           bool_t;           /**< Boolean type
 
 /* some math inline function */
 #define ABS(x)             ((x)>=0? (x): -(x))      /**< simple abs function         */
+#define MAX(a, b)          ((a)>(b)? (a): (b))      /**< larger one of two values    */
+#define MIN(a, b)          ((a)<(b)? (a): (b))      /**< smaller one of two values   */
 
 /** assert function */
 #define ASSERT(EX) 								\
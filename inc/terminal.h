@@ -0,0 +1,74 @@
+/**
+ ********************************************************************************
+ * @file       terminal.h
+ * @version    V0.7.4
+ * @date       2020.04.18
+ * @brief      Character cell terminal widget header file.
+ *******************************************************************************
+ */
+
+#ifndef __GUI_TERMINAL_H__
+#define __GUI_TERMINAL_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* colour index of cell attribute, same order as VT100 */
+#define GUI_TERM_BLACK              0
+#define GUI_TERM_RED                1
+#define GUI_TERM_GREEN              2
+#define GUI_TERM_YELLOW             3
+#define GUI_TERM_BLUE               4
+#define GUI_TERM_MAGENTA            5
+#define GUI_TERM_CYAN               6
+#define GUI_TERM_WHITE              7
+
+/* cell attribute: foreground index on low nibble, background on high nibble */
+#define GUI_TERM_ATTR(fg, bg)       ((uint8_t)(((bg) << 4) | (fg)))
+#define GUI_TERM_ATTR_FG(a)         ((a) & 0x07)
+#define GUI_TERM_ATTR_BG(a)         (((a) >> 4) & 0x07)
+#define GUI_TERM_ATTR_DEFAULT       GUI_TERM_ATTR(GUI_TERM_WHITE, GUI_TERM_BLACK)
+
+/* cell: character on low byte, attribute on high byte */
+#define GUI_TERM_CELL(c, a)         ((uint16_t)(((a) << 8) | (uint8_t)(c)))
+#define GUI_TERM_CELL_CHAR(cell)    ((char)((cell) & 0xFF))
+#define GUI_TERM_CELL_ATTR(cell)    ((uint8_t)((cell) >> 8))
+
+#define GUI_TERM_MAX_PARAMS         4           /**< numbers in one escape sequence     */
+
+/**
+ * @struct   terminal terminal.h
+ * @brief    Terminal struct
+ * @details  This struct is kept in user data of terminal widget. Screen lines
+ *           are a ring, so scrolling only moves the head. Each line records
+ *           the columns changed since last repaint.
+ */
+struct terminal
+{
+    font_t *         font;                           /**< fixed width font of cells              */
+    int16_t          cols, rows;                     /**< size of screen in cells                */
+    int16_t          cx, cy;                         /**< cursor position                        */
+    int16_t          head;                           /**< ring line shown on first screen row    */
+    int16_t          scrolled;                       /**< lines scrolled since last repaint      */
+    uint8_t          attr;                           /**< attribute of new cells                 */
+    uint8_t          state;                          /**< escape sequence parser state           */
+    int16_t          params[GUI_TERM_MAX_PARAMS];    /**< numbers of escape sequence             */
+    int16_t          nparams;                        /**< how many numbers got                   */
+    uint16_t *       cells;                          /**< rows * cols cells, by ring line        */
+    int16_t *        dirty;                          /**< changed columns x1, x2 of ring line    */
+};
+typedef struct terminal terminal_t;
+
+struct window;
+
+widget_t *gui_terminal_create(struct window *top, rect_t *rect, font_t *font);
+
+void gui_terminal_write(widget_t *term, const char *str);
+void gui_terminal_clear(widget_t *term);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __GUI_TERMINAL_H__ */
@@ -30,6 +30,7 @@ struct window;
 #define GUI_WIDGET_TYPE_INIT          0x010       /**< Inital type                */
 #define GUI_WIDGET_TYPE_WIDGET        0x020       /**< It is a widget             */
 #define GUI_WIDGET_BORDER             0x040       /**< Border enable              */
+#define GUI_WIDGET_TYPE_CONTAINER     0x080       /**< It can hold child widgets  */
 
 /* widget node flag define field */
 #define GUI_WIDGET_FLAG_MASK          0x0F00       /**< B(1111 0000 0000)          */
@@ -50,6 +51,14 @@ struct window;
 #define GUI_WIDGET_DISABLE(w)         GUI_WIDGET((w))->flag &= ~GUI_WIDGET_FLAG_SHOWN
 #define COGUI_WIDGET_IS_ENABLE(w)       (GUI_WIDGET((w))->flag & GUI_WIDGET_FLAG_SHOWN)
 
+/* opaque: shown and filled rectangle not blended, covers everything under it */
+#define GUI_WIDGET_OPAQUE_MASK        (GUI_WIDGET_FLAG_SHOWN | GUI_WIDGET_FLAG_RECT | GUI_WIDGET_FLAG_FILLED)
+#define GUI_WIDGET_IS_OPAQUE(w)       ((GUI_WIDGET((w))->flag & GUI_WIDGET_OPAQUE_MASK) == GUI_WIDGET_OPAQUE_MASK && \
+                                       GUI_WIDGET((w))->gc.blend == GUI_BLEND_NONE)
+
+/* container */
+#define GUI_WIDGET_IS_CONTAINER(w)    (GUI_WIDGET((w))->flag & GUI_WIDGET_TYPE_CONTAINER)
+
 /* focus */
 #define GUI_WIDGET_FOCUS(w)           GUI_WIDGET((w))->flag |= GUI_WIDGET_FLAG_FOCUS
 #define GUI_WIDGET_UNFOCUS(w)         GUI_WIDGET((w))->flag &= ~GUI_WIDGET_FLAG_FOCUS
@@ -66,13 +75,18 @@ struct widget
 {
     /* node data field */
     struct widget *   next;                       /**< the next widget                        */
+    struct widget *   parent;                     /**< container widget, Co_NULL if top level */
+    struct widget *   children;                   /**< first child widget of container        */
     struct window *   top;                        /**< the window that contains this widget   */
 
     /* meta data field */
     uint64_t          flag;                       /**< widget flag                            */
     int32_t           id;                         /**< widget id (belong to top window)       */
     uint16_t          dc_type;                    /**< hardware device context                */
-    struct rect       extent;                     /**< the widget extent                      */
+    struct rect       extent;                     /**< the widget physical extent (cached)    */
+    struct rect       rel_extent;                 /**< the widget extent relative to parent   */
+    struct point      origin;                     /**< parent origin the extent is based on   */
+    struct point      scroll;                     /**< content offset of container            */
     struct rect       inner_extent;               /**< the widget extent for drawing          */
     int16_t           min_width, min_height;      /**< minimal width and height of widget     */
    
@@ -82,12 +96,18 @@ struct widget
 
     /* user private data field */
     char *            text;                       /**< text need to print                     */
+    uint16_t          text_len;                   /**< length of text                         */
+    uint16_t          text_cap;                   /**< buffer size, 0 if text is borrowed     */
+    const struct image *image;                    /**< picture in middle, can be Co_NULL      */
     void *            user_data;                  /**< user private data                      */
 
     /* event handler field */
     StatusType (*on_focus_in)(struct widget *widget, struct event *event);      /**< on focus in call back function  */
     StatusType (*on_focus_out)(struct widget *widget, struct event *event);     /**< on focus out call back function */
     StatusType (*handler)(struct widget *widget ,struct event *event);          /**< event handler function          */
+
+    /* drawing field */
+    void (*on_draw)(struct widget *widget, struct rect *clip);                  /**< draws widget instead of its flags */
 };
 typedef struct widget widget_t;
 
@@ -105,6 +125,11 @@ widget_t *gui_widget_list_pop(uint32_t id, struct window *top);
 /* screen node operation function */
 widget_t *gui_get_widget_node(uint32_t id, struct window *top);
 
+/* container widget */
+widget_t *gui_container_create(struct window *top);
+void gui_container_add_child(widget_t *container, widget_t *child);
+void gui_container_remove_child(widget_t *container, widget_t *child);
+
 /* do focus */
 void gui_widget_focus(widget_t *widget);
 void gui_widget_unfocus(widget_t *widget);
@@ -123,14 +148,23 @@ void gui_widget_enable_border(widget_t *widget);
 /* get widget size */
 void gui_widget_get_rect(widget_t *widget, rect_t *rect);
 void gui_widget_get_extent(widget_t *widget, rect_t *rect);
+void gui_widget_update_extent(widget_t *widget);
+bool_t gui_widget_get_clip_extent(widget_t *widget, rect_t *rect);
+
+/* request repaint */
+void gui_widget_invalidate(widget_t *widget);
 
 /* set widget text */
 void gui_widget_set_font(widget_t* widget, font_t *font);
 void gui_widget_set_text_align(widget_t *widget, uint16_t style);
 void gui_widget_set_text(widget_t *widget, const char *text);
+void gui_widget_set_static_text(widget_t *widget, const char *text);
 void gui_widget_append_text(widget_t *widget, const char *text);
 void gui_widget_clear_text(widget_t *widget);
 
+/* set widget picture */
+void gui_widget_set_image(widget_t *widget, const struct image *image);
+
 /* show/hide widget */
 StatusType gui_widget_show(widget_t *widget);
 StatusType gui_widget_onshow(widget_t *widget, struct event *event);
@@ -49,7 +49,15 @@ struct window
     int16_t          id;                             /**< window id -1 for main window          */
     uint16_t         style;                          /**< window style                           */
     int32_t          flag;                           /**< window flag                            */
-    int64_t          update;                         /**< window update count                    */
+    int64_t          update;                         /**< nested update transaction count        */
+    region_t         dirty;                          /**< damaged area waiting for repaint       */
+    rect_t           extent;                         /**< physical area of window on screen      */
+    struct window *  above;                          /**< upper window in z-order                */
+    struct window *  below;                          /**< lower window in z-order                */
+    graphic_driver_t *store;                         /**< offscreen backing store, or Co_NULL    */
+    bool_t           store_valid;                    /**< backing store holds the whole window   */
+    widget_t *       scroll_widget;                  /**< widget scrolled, waiting for a frame   */
+    struct point     scroll_delta;                   /**< pixel motion of the pending scroll     */
     int32_t          widget_cnt;                     /**< how many widgets this window have      */
     widget_t *       focus_widget;                   /**< current focus widget                   */
     app_t *          app;                            /**< window belongs to which application    */
@@ -90,6 +98,18 @@ window_t *gui_main_window_create(void);
 widget_t *gui_window_get_mouse_event_widget(window_t *top, uint16_t cx, uint16_t cy);
 StatusType gui_window_update(window_t *top, widget_t *widget);
 StatusType gui_window_refresh(window_t *top);
+StatusType gui_window_invalidate(window_t *top, rect_t *rect);
+StatusType gui_window_flush(window_t *top, rect_t *painted);
+StatusType gui_window_flush_all(rect_t *painted);
+StatusType gui_window_scroll(window_t *top, widget_t *widget, int32_t dx, int32_t dy);
+
+/* window position and offscreen pixels */
+StatusType gui_window_set_extent(window_t *win, rect_t *rect);
+StatusType gui_window_set_backing_store(window_t *win, bool_t enable);
+
+/* collect repaint requests and paint them once */
+void gui_window_begin_update(window_t *top);
+StatusType gui_window_end_update(window_t *top);
 
 window_t *gui_get_main_window(void);
 window_t *gui_get_current_window(void);
@@ -0,0 +1,243 @@
+/**
+ *******************************************************************************
+ * @file       app_icons.c
+ * @version    V0.7.4
+ * @date       2020.04.18
+ * @brief      Images generated by tools/imgc.py from app_icons.png.
+ *******************************************************************************
+ */
+
+#include "cogui.h"
+
+static const color_t gui_app_icons_palette[] = {
+    GUI_RGB(0x00, 0x00, 0x00),
+    GUI_RGB(0x10, 0x78, 0x63),
+    GUI_RGB(0x16, 0xA0, 0x85),
+    GUI_RGB(0x1D, 0x82, 0x48),
+    GUI_RGB(0x27, 0x36, 0x46),
+    GUI_RGB(0x27, 0xAE, 0x60),
+    GUI_RGB(0x34, 0x49, 0x5E),
+    GUI_RGB(0x5F, 0x69, 0x69),
+    GUI_RGB(0x6A, 0x33, 0x81),
+    GUI_RGB(0x7F, 0x8C, 0x8D),
+    GUI_RGB(0x8E, 0x44, 0xAD),
+    GUI_RGB(0x90, 0x2A, 0x20),
+    GUI_RGB(0xAC, 0x5E, 0x19),
+    GUI_RGB(0xAE, 0x32, 0x6E),
+    GUI_RGB(0xB4, 0x93, 0x0B),
+    GUI_RGB(0xC0, 0x39, 0x2B),
+    GUI_RGB(0xE6, 0x7E, 0x22),
+    GUI_RGB(0xE8, 0x43, 0x93),
+    GUI_RGB(0xF1, 0xC4, 0x0F),
+    GUI_RGB(0xFF, 0xFF, 0xFF),
+};
+
+static const uint8_t gui_app_icons_data0[] = {
+    0x88,0x00,0xA9,0x06,0x8E,0x00,0xAF,0x06,0x8A,0x00,0xB1,0x06,0x88,0x00,0xB3,0x06,
+    0x86,0x00,0xB5,0x06,0x84,0x00,0xB7,0x06,0x82,0x00,0xB9,0x06,0x81,0x00,0xB9,0x06,
+    0x81,0x00,0xB9,0x06,0x00,0x00,0xFF,0x06,0xFF,0x06,0xFF,0x06,0xFF,0x06,0xA9,0x06,
+    0x83,0x13,0xB7,0x06,0x84,0x13,0xB6,0x06,0x86,0x13,0xB4,0x06,0x87,0x13,0xB4,0x06,
+    0x87,0x13,0xB4,0x06,0x87,0x13,0xB4,0x06,0x87,0x13,0xB5,0x06,0x87,0x13,0xB4,0x06,
+    0x87,0x13,0xB4,0x06,0x87,0x13,0xB4,0x06,0x87,0x13,0xB4,0x06,0x86,0x13,0xB4,0x06,
+    0x86,0x13,0xB3,0x06,0x87,0x13,0xB2,0x06,0x87,0x13,0xB2,0x06,0x87,0x13,0xB2,0x06,
+    0x87,0x13,0xB1,0x06,0x87,0x13,0xB2,0x06,0x87,0x13,0xB2,0x06,0x87,0x13,0xB2,0x06,
+    0x87,0x13,0x89,0x06,0x8D,0x13,0x9B,0x06,0x86,0x13,0x8A,0x06,0x8D,0x13,0x9B,0x06,
+    0x84,0x13,0x8C,0x06,0x8D,0x13,0x9B,0x06,0x83,0x13,0x8D,0x06,0x8D,0x13,0xFF,0x06,
+    0xFF,0x06,0xFF,0x06,0xFF,0x06,0xA9,0x06,0x00,0x00,0xB9,0x06,0x81,0x00,0xB9,0x06,
+    0x81,0x00,0xB9,0x06,0x82,0x00,0xB7,0x06,0x84,0x00,0xB5,0x06,0x86,0x00,0xB3,0x04,
+    0x88,0x00,0xB1,0x04,0x8A,0x00,0xAF,0x04,0x8E,0x00,0xA9,0x04,0x88,0x00,
+};
+
+static const uint8_t gui_app_icons_data1[] = {
+    0x88,0x00,0xA9,0x05,0x8E,0x00,0xAF,0x05,0x8A,0x00,0xB1,0x05,0x88,0x00,0xB3,0x05,
+    0x86,0x00,0xB5,0x05,0x84,0x00,0xB7,0x05,0x82,0x00,0xB9,0x05,0x81,0x00,0xB9,0x05,
+    0x81,0x00,0xB9,0x05,0x00,0x00,0xFF,0x05,0xFF,0x05,0xFF,0x05,0xB2,0x05,0x83,0x13,
+    0xB6,0x05,0x85,0x13,0x83,0x05,0x95,0x13,0x9B,0x05,0x85,0x13,0x83,0x05,0x95,0x13,
+    0x9B,0x05,0x85,0x13,0x83,0x05,0x95,0x13,0x9B,0x05,0x85,0x13,0x83,0x05,0x95,0x13,
+    0x9C,0x05,0x83,0x13,0xFF,0x05,0xFF,0x05,0xE3,0x05,0x83,0x13,0xB6,0x05,0x85,0x13,
+    0x83,0x05,0x95,0x13,0x9B,0x05,0x85,0x13,0x83,0x05,0x95,0x13,0x9B,0x05,0x85,0x13,
+    0x83,0x05,0x95,0x13,0x9B,0x05,0x85,0x13,0x83,0x05,0x95,0x13,0x9C,0x05,0x83,0x13,
+    0xFF,0x05,0xFF,0x05,0xE3,0x05,0x83,0x13,0xB6,0x05,0x85,0x13,0x83,0x05,0x95,0x13,
+    0x9B,0x05,0x85,0x13,0x83,0x05,0x95,0x13,0x9B,0x05,0x85,0x13,0x83,0x05,0x95,0x13,
+    0x9B,0x05,0x85,0x13,0x83,0x05,0x95,0x13,0x9C,0x05,0x83,0x13,0xFF,0x05,0xFF,0x05,
+    0xFF,0x05,0xCC,0x05,0x00,0x00,0xB9,0x05,0x81,0x00,0xB9,0x05,0x81,0x00,0xB9,0x05,
+    0x82,0x00,0xB7,0x05,0x84,0x00,0xB5,0x05,0x86,0x00,0xB3,0x03,0x88,0x00,0xB1,0x03,
+    0x8A,0x00,0xAF,0x03,0x8E,0x00,0xA9,0x03,0x88,0x00,
+};
+
+static const uint8_t gui_app_icons_data2[] = {
+    0x88,0x00,0xA9,0x10,0x8E,0x00,0xAF,0x10,0x8A,0x00,0xB1,0x10,0x88,0x00,0xB3,0x10,
+    0x86,0x00,0xB5,0x10,0x84,0x00,0xB7,0x10,0x82,0x00,0xB9,0x10,0x81,0x00,0xB9,0x10,
+    0x81,0x00,0xB9,0x10,0x00,0x00,0x99,0x10,0x87,0x13,0xAF,0x10,0x8F,0x13,0xA9,0x10,
+    0x93,0x13,0xA6,0x10,0x95,0x13,0xA3,0x10,0x88,0x13,0x87,0x10,0x88,0x13,0xA0,0x10,
+    0x86,0x13,0x8D,0x10,0x86,0x13,0x9E,0x10,0x85,0x13,0x87,0x10,0x81,0x13,0x87,0x10,
+    0x85,0x13,0x9C,0x10,0x85,0x13,0x87,0x10,0x83,0x13,0x87,0x10,0x85,0x13,0x9B,0x10,
+    0x84,0x13,0x88,0x10,0x83,0x13,0x88,0x10,0x84,0x13,0x9A,0x10,0x84,0x13,0x89,0x10,
+    0x83,0x13,0x89,0x10,0x84,0x13,0x98,0x10,0x84,0x13,0x8A,0x10,0x83,0x13,0x8A,0x10,
+    0x84,0x13,0x97,0x10,0x83,0x13,0x8B,0x10,0x83,0x13,0x8B,0x10,0x83,0x13,0x96,0x10,
+    0x84,0x13,0x8B,0x10,0x83,0x13,0x8B,0x10,0x84,0x13,0x95,0x10,0x83,0x13,0x8C,0x10,
+    0x83,0x13,0x8C,0x10,0x83,0x13,0x95,0x10,0x83,0x13,0x8C,0x10,0x83,0x13,0x8C,0x10,
+    0x83,0x13,0x95,0x10,0x83,0x13,0x8C,0x10,0x83,0x13,0x8C,0x10,0x83,0x13,0x94,0x10,
+    0x83,0x13,0x8D,0x10,0x83,0x13,0x8D,0x10,0x83,0x13,0x93,0x10,0x83,0x13,0x8D,0x10,
+    0x83,0x13,0x8D,0x10,0x83,0x13,0x93,0x10,0x83,0x13,0x8D,0x10,0x83,0x13,0x8D,0x10,
+    0x83,0x13,0x93,0x10,0x83,0x13,0x8D,0x10,0x85,0x13,0x8B,0x10,0x83,0x13,0x93,0x10,
+    0x83,0x13,0x8D,0x10,0x87,0x13,0x89,0x10,0x83,0x13,0x93,0x10,0x83,0x13,0x8E,0x10,
+    0x88,0x13,0x87,0x10,0x83,0x13,0x93,0x10,0x83,0x13,0x90,0x10,0x88,0x13,0x85,0x10,
+    0x83,0x13,0x93,0x10,0x83,0x13,0x92,0x10,0x87,0x13,0x84,0x10,0x83,0x13,0x94,0x10,
+    0x83,0x13,0x93,0x10,0x85,0x13,0x83,0x10,0x83,0x13,0x95,0x10,0x83,0x13,0x95,0x10,
+    0x82,0x13,0x84,0x10,0x83,0x13,0x95,0x10,0x83,0x13,0x9D,0x10,0x83,0x13,0x95,0x10,
+    0x84,0x13,0x9B,0x10,0x84,0x13,0x96,0x10,0x83,0x13,0x9B,0x10,0x83,0x13,0x97,0x10,
+    0x84,0x13,0x99,0x10,0x84,0x13,0x98,0x10,0x84,0x13,0x97,0x10,0x84,0x13,0x9A,0x10,
+    0x84,0x13,0x95,0x10,0x84,0x13,0x9B,0x10,0x85,0x13,0x93,0x10,0x85,0x13,0x9C,0x10,
+    0x85,0x13,0x91,0x10,0x85,0x13,0x9E,0x10,0x86,0x13,0x8D,0x10,0x86,0x13,0xA0,0x10,
+    0x88,0x13,0x87,0x10,0x88,0x13,0xA3,0x10,0x95,0x13,0xA6,0x10,0x93,0x13,0xA9,0x10,
+    0x8F,0x13,0xAF,0x10,0x87,0x13,0xFF,0x10,0x91,0x10,0x00,0x00,0xB9,0x10,0x81,0x00,
+    0xB9,0x10,0x81,0x00,0xB9,0x10,0x82,0x00,0xB7,0x10,0x84,0x00,0xB5,0x10,0x86,0x00,
+    0xB3,0x0C,0x88,0x00,0xB1,0x0C,0x8A,0x00,0xAF,0x0C,0x8E,0x00,0xA9,0x0C,0x88,0x00,
+};
+
+static const uint8_t gui_app_icons_data3[] = {
+    0x88,0x00,0xA9,0x0F,0x8E,0x00,0xAF,0x0F,0x8A,0x00,0xB1,0x0F,0x88,0x00,0xB3,0x0F,
+    0x86,0x00,0xB5,0x0F,0x84,0x00,0xB7,0x0F,0x82,0x00,0xB9,0x0F,0x81,0x00,0xB9,0x0F,
+    0x81,0x00,0xB9,0x0F,0x00,0x00,0xFF,0x0F,0xFF,0x0F,0xFF,0x0F,0xEB,0x0F,0x82,0x02,
+    0x9D,0x13,0x82,0x02,0x97,0x0F,0x83,0x02,0x9B,0x13,0x83,0x02,0x97,0x0F,0x84,0x02,
+    0x99,0x13,0x84,0x02,0x97,0x0F,0x81,0x13,0x84,0x02,0x95,0x13,0x84,0x02,0x81,0x13,
+    0x97,0x0F,0x82,0x13,0x84,0x02,0x93,0x13,0x84,0x02,0x82,0x13,0x97,0x0F,0x83,0x13,
+    0x84,0x02,0x91,0x13,0x84,0x02,0x83,0x13,0x97,0x0F,0x85,0x13,0x84,0x02,0x8D,0x13,
+    0x84,0x02,0x85,0x13,0x97,0x0F,0x86,0x13,0x84,0x02,0x8B,0x13,0x84,0x02,0x86,0x13,
+    0x97,0x0F,0x87,0x13,0x84,0x02,0x89,0x13,0x84,0x02,0x87,0x13,0x97,0x0F,0x89,0x13,
+    0x84,0x02,0x85,0x13,0x84,0x02,0x89,0x13,0x97,0x0F,0x8A,0x13,0x84,0x02,0x83,0x13,
+    0x84,0x02,0x8A,0x13,0x97,0x0F,0x8B,0x13,0x84,0x02,0x81,0x13,0x84,0x02,0x8B,0x13,
+    0x97,0x0F,0x8D,0x13,0x87,0x02,0x8D,0x13,0x97,0x0F,0x8E,0x13,0x85,0x02,0x8E,0x13,
+    0x97,0x0F,0x8F,0x13,0x83,0x02,0x8F,0x13,0x97,0x0F,0xA3,0x13,0x97,0x0F,0xA3,0x13,
+    0x97,0x0F,0xA3,0x13,0x97,0x0F,0xA3,0x13,0x97,0x0F,0xA3,0x13,0x97,0x0F,0xA3,0x13,
+    0x97,0x0F,0xA3,0x13,0x97,0x0F,0xA3,0x13,0x97,0x0F,0xA3,0x13,0xFF,0x0F,0xFF,0x0F,
+    0xFF,0x0F,0xFF,0x0F,0xE3,0x0F,0x00,0x00,0xB9,0x0F,0x81,0x00,0xB9,0x0F,0x81,0x00,
+    0xB9,0x0F,0x82,0x00,0xB7,0x0F,0x84,0x00,0xB5,0x0F,0x86,0x00,0xB3,0x0B,0x88,0x00,
+    0xB1,0x0B,0x8A,0x00,0xAF,0x0B,0x8E,0x00,0xA9,0x0B,0x88,0x00,
+};
+
+static const uint8_t gui_app_icons_data4[] = {
+    0x88,0x00,0xA9,0x0A,0x8E,0x00,0xAF,0x0A,0x8A,0x00,0xB1,0x0A,0x88,0x00,0xB3,0x0A,
+    0x86,0x00,0xB5,0x0A,0x84,0x00,0xB7,0x0A,0x82,0x00,0xB9,0x0A,0x81,0x00,0xB9,0x0A,
+    0x81,0x00,0xB9,0x0A,0x00,0x00,0xFF,0x0A,0xFF,0x0A,0xD1,0x0A,0x87,0x13,0xB3,0x0A,
+    0x87,0x13,0xB3,0x0A,0x87,0x13,0xB3,0x0A,0x87,0x13,0xB3,0x0A,0x87,0x13,0xB3,0x0A,
+    0x87,0x13,0xB3,0x0A,0x87,0x13,0xB3,0x0A,0x87,0x13,0xA7,0x0A,0x87,0x13,0x83,0x0A,
+    0x87,0x13,0xA7,0x0A,0x87,0x13,0x83,0x0A,0x87,0x13,0xA7,0x0A,0x87,0x13,0x83,0x0A,
+    0x87,0x13,0xA7,0x0A,0x87,0x13,0x83,0x0A,0x87,0x13,0xA7,0x0A,0x87,0x13,0x83,0x0A,
+    0x87,0x13,0xA7,0x0A,0x87,0x13,0x83,0x0A,0x87,0x13,0xA7,0x0A,0x87,0x13,0x83,0x0A,
+    0x87,0x13,0xA7,0x0A,0x87,0x13,0x83,0x0A,0x87,0x13,0xA7,0x0A,0x87,0x13,0x83,0x0A,
+    0x87,0x13,0xA7,0x0A,0x87,0x13,0x83,0x0A,0x87,0x13,0x9B,0x0A,0x87,0x13,0x83,0x0A,
+    0x87,0x13,0x83,0x0A,0x87,0x13,0x9B,0x0A,0x87,0x13,0x83,0x0A,0x87,0x13,0x83,0x0A,
+    0x87,0x13,0x9B,0x0A,0x87,0x13,0x83,0x0A,0x87,0x13,0x83,0x0A,0x87,0x13,0x9B,0x0A,
+    0x87,0x13,0x83,0x0A,0x87,0x13,0x83,0x0A,0x87,0x13,0x9B,0x0A,0x87,0x13,0x83,0x0A,
+    0x87,0x13,0x83,0x0A,0x87,0x13,0x9B,0x0A,0x87,0x13,0x83,0x0A,0x87,0x13,0x83,0x0A,
+    0x87,0x13,0x9B,0x0A,0x87,0x13,0x83,0x0A,0x87,0x13,0x83,0x0A,0x87,0x13,0x9B,0x0A,
+    0x87,0x13,0x83,0x0A,0x87,0x13,0x83,0x0A,0x87,0x13,0x9B,0x0A,0x87,0x13,0x83,0x0A,
+    0x87,0x13,0x83,0x0A,0x87,0x13,0x9B,0x0A,0x87,0x13,0x83,0x0A,0x87,0x13,0x83,0x0A,
+    0x87,0x13,0x9B,0x0A,0x87,0x13,0x83,0x0A,0x87,0x13,0x83,0x0A,0x87,0x13,0x9B,0x0A,
+    0x87,0x13,0x83,0x0A,0x87,0x13,0x83,0x0A,0x87,0x13,0x9B,0x0A,0x87,0x13,0x83,0x0A,
+    0x87,0x13,0x83,0x0A,0x87,0x13,0xFF,0x0A,0xFF,0x0A,0xF5,0x0A,0x00,0x00,0xB9,0x0A,
+    0x81,0x00,0xB9,0x0A,0x81,0x00,0xB9,0x0A,0x82,0x00,0xB7,0x0A,0x84,0x00,0xB5,0x0A,
+    0x86,0x00,0xB3,0x08,0x88,0x00,0xB1,0x08,0x8A,0x00,0xAF,0x08,0x8E,0x00,0xA9,0x08,
+    0x88,0x00,
+};
+
+static const uint8_t gui_app_icons_data5[] = {
+    0x88,0x00,0xA9,0x12,0x8E,0x00,0xAF,0x12,0x8A,0x00,0xB1,0x12,0x88,0x00,0xB3,0x12,
+    0x86,0x00,0xB5,0x12,0x84,0x00,0xB7,0x12,0x82,0x00,0xB9,0x12,0x81,0x00,0xB9,0x12,
+    0x81,0x00,0xB9,0x12,0x00,0x00,0xFF,0x12,0xFF,0x12,0xFF,0x12,0xFF,0x12,0xA7,0x12,
+    0x8D,0x13,0xAD,0x12,0x8D,0x13,0xAD,0x12,0x8D,0x13,0xAD,0x12,0x8D,0x13,0xAD,0x12,
+    0xA3,0x13,0x97,0x12,0xA3,0x13,0x97,0x12,0xA3,0x13,0x97,0x12,0xA3,0x13,0x97,0x12,
+    0xA3,0x13,0x97,0x12,0xA3,0x13,0x97,0x12,0xA3,0x13,0x97,0x12,0xA3,0x13,0x97,0x12,
+    0xA3,0x13,0x97,0x12,0xA3,0x13,0x97,0x12,0xA3,0x13,0x97,0x12,0xA3,0x13,0x97,0x12,
+    0xA3,0x13,0x97,0x12,0xA3,0x13,0x97,0x12,0xA3,0x13,0x97,0x12,0xA3,0x13,0x97,0x12,
+    0xA3,0x13,0x97,0x12,0xA3,0x13,0x97,0x12,0xA3,0x13,0x97,0x12,0xA3,0x13,0x97,0x12,
+    0xA3,0x13,0xFF,0x12,0xFF,0x12,0xFF,0x12,0xEB,0x12,0x00,0x00,0xB9,0x12,0x81,0x00,
+    0xB9,0x12,0x81,0x00,0xB9,0x12,0x82,0x00,0xB7,0x12,0x84,0x00,0xB5,0x12,0x86,0x00,
+    0xB3,0x0E,0x88,0x00,0xB1,0x0E,0x8A,0x00,0xAF,0x0E,0x8E,0x00,0xA9,0x0E,0x88,0x00,
+};
+
+static const uint8_t gui_app_icons_data6[] = {
+    0x88,0x00,0xA9,0x11,0x8E,0x00,0xAF,0x11,0x8A,0x00,0xB1,0x11,0x88,0x00,0xB3,0x11,
+    0x86,0x00,0xB5,0x11,0x84,0x00,0xB7,0x11,0x82,0x00,0xB9,0x11,0x81,0x00,0xB9,0x11,
+    0x81,0x00,0xB9,0x11,0x00,0x00,0xFF,0x11,0xFF,0x11,0xC7,0x11,0x81,0x13,0xB8,0x11,
+    0x84,0x13,0xB6,0x11,0x86,0x13,0xB4,0x11,0x88,0x13,0xB2,0x11,0x8A,0x13,0xB0,0x11,
+    0x8C,0x13,0xAE,0x11,0x83,0x13,0x81,0x11,0x87,0x13,0xAD,0x11,0x83,0x13,0x83,0x11,
+    0x86,0x13,0xAC,0x11,0x83,0x13,0x85,0x11,0x84,0x13,0xAC,0x11,0x83,0x13,0x87,0x11,
+    0x81,0x13,0xAD,0x11,0x83,0x13,0xB7,0x11,0x83,0x13,0xB7,0x11,0x83,0x13,0xB7,0x11,
+    0x83,0x13,0xB7,0x11,0x83,0x13,0xB7,0x11,0x83,0x13,0xB7,0x11,0x83,0x13,0xB7,0x11,
+    0x83,0x13,0xB7,0x11,0x83,0x13,0xB2,0x11,0x83,0x13,0x00,0x11,0x83,0x13,0xB0,0x11,
+    0x8A,0x13,0xAF,0x11,0x8B,0x13,0xAF,0x11,0x8B,0x13,0xAE,0x11,0x8C,0x13,0xAE,0x11,
+    0x8C,0x13,0xAE,0x11,0x8B,0x13,0xAF,0x11,0x8B,0x13,0xB0,0x11,0x89,0x13,0xB1,0x11,
+    0x89,0x13,0xB2,0x11,0x87,0x13,0xB5,0x11,0x83,0x13,0xFF,0x11,0xFF,0x11,0xFF,0x11,
+    0x89,0x11,0x00,0x00,0xB9,0x11,0x81,0x00,0xB9,0x11,0x81,0x00,0xB9,0x11,0x82,0x00,
+    0xB7,0x11,0x84,0x00,0xB5,0x11,0x86,0x00,0xB3,0x0D,0x88,0x00,0xB1,0x0D,0x8A,0x00,
+    0xAF,0x0D,0x8E,0x00,0xA9,0x0D,0x88,0x00,
+};
+
+static const uint8_t gui_app_icons_data7[] = {
+    0x88,0x00,0xA9,0x09,0x8E,0x00,0xAF,0x09,0x8A,0x00,0xB1,0x09,0x88,0x00,0xB3,0x09,
+    0x86,0x00,0xB5,0x09,0x84,0x00,0xB7,0x09,0x82,0x00,0xB9,0x09,0x81,0x00,0x9A,0x09,
+    0x83,0x13,0x9A,0x09,0x81,0x00,0x99,0x09,0x85,0x13,0x99,0x09,0x00,0x00,0x9A,0x09,
+    0x85,0x13,0xB4,0x09,0x86,0x13,0xB4,0x09,0x86,0x13,0xA9,0x09,0x82,0x13,0x87,0x09,
+    0x86,0x13,0x88,0x09,0x82,0x13,0x9C,0x09,0x84,0x13,0x86,0x09,0x86,0x13,0x87,0x09,
+    0x84,0x13,0x9A,0x09,0x86,0x13,0x85,0x09,0x86,0x13,0x86,0x09,0x86,0x13,0x99,0x09,
+    0x87,0x13,0x84,0x09,0x87,0x13,0x84,0x09,0x87,0x13,0x99,0x09,0x88,0x13,0x81,0x09,
+    0x8B,0x13,0x81,0x09,0x88,0x13,0x9A,0x09,0x9F,0x13,0x9C,0x09,0x9D,0x13,0x9E,0x09,
+    0x9B,0x13,0xA0,0x09,0x99,0x13,0xA2,0x09,0x97,0x13,0xA3,0x09,0x97,0x13,0xA2,0x09,
+    0x8A,0x13,0x83,0x02,0x8A,0x13,0xA1,0x09,0x88,0x13,0x87,0x02,0x88,0x13,0xA0,0x09,
+    0x88,0x13,0x89,0x02,0x8D,0x13,0x93,0x09,0x8F,0x13,0x89,0x02,0x8F,0x13,0x90,0x09,
+    0x8F,0x13,0x8B,0x02,0x8F,0x13,0x8F,0x09,0x8F,0x13,0x8B,0x02,0x8F,0x13,0x8F,0x09,
+    0x8F,0x13,0x8B,0x02,0x8F,0x13,0x8F,0x09,0x8F,0x13,0x8B,0x02,0x8F,0x13,0x90,0x09,
+    0x8F,0x13,0x89,0x02,0x8F,0x13,0x93,0x09,0x8D,0x13,0x89,0x02,0x8D,0x13,0x9B,0x09,
+    0x88,0x13,0x87,0x02,0x88,0x13,0xA1,0x09,0x8A,0x13,0x83,0x02,0x8A,0x13,0xA2,0x09,
+    0x97,0x13,0xA3,0x09,0x97,0x13,0xA2,0x09,0x99,0x13,0xA0,0x09,0x9B,0x13,0x9E,0x09,
+    0x9D,0x13,0x9C,0x09,0x9F,0x13,0x9A,0x09,0x88,0x13,0x81,0x09,0x8B,0x13,0x81,0x09,
+    0x88,0x13,0x99,0x09,0x87,0x13,0x84,0x09,0x87,0x13,0x84,0x09,0x87,0x13,0x99,0x09,
+    0x86,0x13,0x85,0x09,0x87,0x13,0x85,0x09,0x86,0x13,0x9A,0x09,0x84,0x13,0x86,0x09,
+    0x87,0x13,0x86,0x09,0x84,0x13,0x9C,0x09,0x82,0x13,0x87,0x09,0x87,0x13,0x87,0x09,
+    0x82,0x13,0xA8,0x09,0x87,0x13,0xB3,0x09,0x87,0x13,0xB4,0x09,0x85,0x13,0xB5,0x09,
+    0x85,0x13,0xB6,0x09,0x83,0x13,0x9B,0x09,0x00,0x00,0xB9,0x09,0x81,0x00,0xB9,0x09,
+    0x81,0x00,0xB9,0x09,0x82,0x00,0xB7,0x09,0x84,0x00,0xB5,0x09,0x86,0x00,0xB3,0x07,
+    0x88,0x00,0xB1,0x07,0x8A,0x00,0xAF,0x07,0x8E,0x00,0xA9,0x07,0x88,0x00,
+};
+
+static const uint8_t gui_app_icons_data8[] = {
+    0x88,0x00,0xA9,0x02,0x8E,0x00,0xAF,0x02,0x8A,0x00,0xB1,0x02,0x88,0x00,0xB3,0x02,
+    0x86,0x00,0xB5,0x02,0x84,0x00,0xB7,0x02,0x82,0x00,0xB9,0x02,0x81,0x00,0xB9,0x02,
+    0x81,0x00,0xB9,0x02,0x00,0x00,0xFF,0x02,0xFD,0x02,0x87,0x13,0x83,0x02,0x87,0x13,
+    0x83,0x02,0x87,0x13,0x9B,0x02,0x87,0x13,0x83,0x02,0x87,0x13,0x83,0x02,0x87,0x13,
+    0x9B,0x02,0x87,0x13,0x83,0x02,0x87,0x13,0x83,0x02,0x87,0x13,0x9B,0x02,0x87,0x13,
+    0x83,0x02,0x87,0x13,0x83,0x02,0x87,0x13,0x9B,0x02,0x87,0x13,0x83,0x02,0x87,0x13,
+    0x83,0x02,0x87,0x13,0x9B,0x02,0x87,0x13,0x83,0x02,0x87,0x13,0x83,0x02,0x87,0x13,
+    0x9B,0x02,0x87,0x13,0x83,0x02,0x87,0x13,0x83,0x02,0x87,0x13,0x9B,0x02,0x87,0x13,
+    0x83,0x02,0x87,0x13,0x83,0x02,0x87,0x13,0xFF,0x02,0xFF,0x02,0x8B,0x02,0x87,0x13,
+    0x83,0x02,0x87,0x13,0x83,0x02,0x87,0x13,0x9B,0x02,0x87,0x13,0x83,0x02,0x87,0x13,
+    0x83,0x02,0x87,0x13,0x9B,0x02,0x87,0x13,0x83,0x02,0x87,0x13,0x83,0x02,0x87,0x13,
+    0x9B,0x02,0x87,0x13,0x83,0x02,0x87,0x13,0x83,0x02,0x87,0x13,0x9B,0x02,0x87,0x13,
+    0x83,0x02,0x87,0x13,0x83,0x02,0x87,0x13,0x9B,0x02,0x87,0x13,0x83,0x02,0x87,0x13,
+    0x83,0x02,0x87,0x13,0x9B,0x02,0x87,0x13,0x83,0x02,0x87,0x13,0x83,0x02,0x87,0x13,
+    0x9B,0x02,0x87,0x13,0x83,0x02,0x87,0x13,0x83,0x02,0x87,0x13,0xFF,0x02,0xFF,0x02,
+    0x8B,0x02,0x87,0x13,0x83,0x02,0x87,0x13,0x83,0x02,0x87,0x13,0x9B,0x02,0x87,0x13,
+    0x83,0x02,0x87,0x13,0x83,0x02,0x87,0x13,0x9B,0x02,0x87,0x13,0x83,0x02,0x87,0x13,
+    0x83,0x02,0x87,0x13,0x9B,0x02,0x87,0x13,0x83,0x02,0x87,0x13,0x83,0x02,0x87,0x13,
+    0x9B,0x02,0x87,0x13,0x83,0x02,0x87,0x13,0x83,0x02,0x87,0x13,0x9B,0x02,0x87,0x13,
+    0x83,0x02,0x87,0x13,0x83,0x02,0x87,0x13,0x9B,0x02,0x87,0x13,0x83,0x02,0x87,0x13,
+    0x83,0x02,0x87,0x13,0x9B,0x02,0x87,0x13,0x83,0x02,0x87,0x13,0x83,0x02,0x87,0x13,
+    0xFF,0x02,0xFF,0x02,0xF5,0x02,0x00,0x00,0xB9,0x02,0x81,0x00,0xB9,0x02,0x81,0x00,
+    0xB9,0x02,0x82,0x00,0xB7,0x02,0x84,0x00,0xB5,0x02,0x86,0x00,0xB3,0x01,0x88,0x00,
+    0xB1,0x01,0x8A,0x00,0xAF,0x01,0x8E,0x00,0xA9,0x01,0x88,0x00,
+};
+
+const image_t gui_app_icons[] = {
+    {GUI_IMAGE_INDEX8, GUI_IMAGE_RLE | GUI_IMAGE_KEY, 60, 60, 0x0, gui_app_icons_palette, (const uint8_t *)gui_app_icons_data0, 0},
+    {GUI_IMAGE_INDEX8, GUI_IMAGE_RLE | GUI_IMAGE_KEY, 60, 60, 0x0, gui_app_icons_palette, (const uint8_t *)gui_app_icons_data1, 0},
+    {GUI_IMAGE_INDEX8, GUI_IMAGE_RLE | GUI_IMAGE_KEY, 60, 60, 0x0, gui_app_icons_palette, (const uint8_t *)gui_app_icons_data2, 0},
+    {GUI_IMAGE_INDEX8, GUI_IMAGE_RLE | GUI_IMAGE_KEY, 60, 60, 0x0, gui_app_icons_palette, (const uint8_t *)gui_app_icons_data3, 0},
+    {GUI_IMAGE_INDEX8, GUI_IMAGE_RLE | GUI_IMAGE_KEY, 60, 60, 0x0, gui_app_icons_palette, (const uint8_t *)gui_app_icons_data4, 0},
+    {GUI_IMAGE_INDEX8, GUI_IMAGE_RLE | GUI_IMAGE_KEY, 60, 60, 0x0, gui_app_icons_palette, (const uint8_t *)gui_app_icons_data5, 0},
+    {GUI_IMAGE_INDEX8, GUI_IMAGE_RLE | GUI_IMAGE_KEY, 60, 60, 0x0, gui_app_icons_palette, (const uint8_t *)gui_app_icons_data6, 0},
+    {GUI_IMAGE_INDEX8, GUI_IMAGE_RLE | GUI_IMAGE_KEY, 60, 60, 0x0, gui_app_icons_palette, (const uint8_t *)gui_app_icons_data7, 0},
+    {GUI_IMAGE_INDEX8, GUI_IMAGE_RLE | GUI_IMAGE_KEY, 60, 60, 0x0, gui_app_icons_palette, (const uint8_t *)gui_app_icons_data8, 0},
+};
@@ -22,3 +22,82 @@ const color_t light_grey   = GUI_RGB(0x9e, 0x9e, 0x9e);     /**< default light g
 const color_t dark_grey    = GUI_RGB(0x42, 0x42, 0x42);     /**< default dark gray color   */ 
 const color_t white        = GUI_RGB(0xff, 0xff, 0xff);     /**< default white color       */ 
 const color_t black        = GUI_RGB(0x00, 0x00, 0x00);     /**< default black color       */ 
+
+/**
+ *******************************************************************************
+ * @brief      Blend foreground color onto background color.
+ * @param[in]  fg       Foreground color.
+ * @param[in]  bg       Background color.
+ * @param[in]  alpha    Foreground weight, 0 for bg and 255 for fg.
+ * @param[out] None
+ * @retval     color    Blended color.
+ *******************************************************************************
+ */
+color_t gui_color_blend(color_t fg, color_t bg, uint8_t alpha)
+{
+    uint32_t a = alpha, na = 255 - alpha;
+    uint32_t c0, c1, c2;
+
+#if defined(USING_RGB565) || defined(USING_BGR565)
+    c0 = (((fg >> 11) & 0x1F) * a + ((bg >> 11) & 0x1F) * na + 127) / 255;
+    c1 = (((fg >> 5)  & 0x3F) * a + ((bg >> 5)  & 0x3F) * na + 127) / 255;
+    c2 = (( fg        & 0x1F) * a + ( bg        & 0x1F) * na + 127) / 255;
+
+    return (color_t)((c0 << 11) | (c1 << 5) | c2);
+#else
+    c0 = (((fg >> 16) & 0xFF) * a + ((bg >> 16) & 0xFF) * na + 127) / 255;
+    c1 = (((fg >> 8)  & 0xFF) * a + ((bg >> 8)  & 0xFF) * na + 127) / 255;
+    c2 = (( fg        & 0xFF) * a + ( bg        & 0xFF) * na + 127) / 255;
+
+    return (fg & 0xFF000000) | (color_t)((c0 << 16) | (c1 << 8) | c2);
+#endif
+}
+
+/**
+ *******************************************************************************
+ * @brief      Change a color to 32 bits ARGB.
+ * @param[in]  c        Color in style of GUI_RGB.
+ * @param[out] None
+ * @retval     argb     Color as 0xAARRGGBB, opaque if style has no alpha.
+ *******************************************************************************
+ */
+uint32_t gui_color_to_argb8888(color_t c)
+{
+#if defined(USING_RGB565) || defined(USING_BGR565)
+    uint32_t r = (c >> 11) & 0x1F;
+    uint32_t g = (c >> 5)  & 0x3F;
+    uint32_t b =  c        & 0x1F;
+
+    /* copy high bits into low bits, so 0x1F is 0xFF */
+    r = (r << 3) | (r >> 2);
+    g = (g << 2) | (g >> 4);
+    b = (b << 3) | (b >> 2);
+#ifdef USING_BGR565
+    _int_swap(r, b);
+#endif
+
+    return 0xFF000000 | (r << 16) | (g << 8) | b;
+#elif defined(USING_ARGB8888)
+    return (uint32_t)c;
+#else
+    return 0xFF000000 | (uint32_t)c;
+#endif
+}
+
+/**
+ *******************************************************************************
+ * @brief      Change a 32 bits ARGB color to style of GUI_RGB.
+ * @param[in]  argb     Color as 0xAARRGGBB.
+ * @param[out] None
+ * @retval     color    Color in style of GUI_RGB, alpha is dropped if style
+ *                      has no alpha.
+ *******************************************************************************
+ */
+color_t gui_color_from_argb8888(uint32_t argb)
+{
+#if defined(USING_ARGB8888)
+    return (color_t)argb;
+#else
+    return GUI_RGB((argb >> 16) & 0xFF, (argb >> 8) & 0xFF, argb & 0xFF);
+#endif
+}
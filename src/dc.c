@@ -9,16 +9,219 @@
 
 #include <cogui.h>
 
+/**
+ *******************************************************************************
+ * @brief      Integer square root
+ * @param[in]  n        Value
+ * @param[out] None
+ * @retval     root     Largest integer whose square is not over n
+ *******************************************************************************
+ */
+static uint32_t _gui_dc_sqrt(uint64_t n)
+{
+    uint64_t root = 0, bit = 1ULL << 62;
+
+    while (bit > n) {
+        bit >>= 2;
+    }
+
+    while (bit) {
+        if (n >= root + bit) {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return (uint32_t)root;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Get steps of a line inside bound
+ * @param[in]  a0       Start on major axis
+ * @param[in]  sa       Direction on major axis, 1 or -1
+ * @param[in]  amin     Smallest major coordinate inside bound
+ * @param[in]  amax     Largest major coordinate inside bound
+ * @param[in]  b0       Start on minor axis
+ * @param[in]  sb       Direction on minor axis, 1 or -1
+ * @param[in]  bmin     Smallest minor coordinate inside bound
+ * @param[in]  bmax     Largest minor coordinate inside bound
+ * @param[in]  da       Length on major axis
+ * @param[in]  db       Length on minor axis, not larger than da
+ * @param[out] *first   First step inside bound
+ * @param[out] *last    Last step inside bound
+ * @retval     1        Some steps are inside bound.
+ * @retval     0        Line is out of bound.
+ *
+ * @par Description
+ * @details    Step i of a line is at a0 + sa * i on major axis and at
+ *             b0 + sb * k(i) on minor axis, k(i) = (2 i db + da - 1) / (2 da)
+ *             as Bresenham does. Like Liang-Barsky the range of i is cut by
+ *             every edge, but on the integer steps, so a clipped line keeps
+ *             the same pixels as the whole one. End point is left out.
+ *******************************************************************************
+ */
+static bool_t _gui_dc_line_range(int32_t a0, int32_t sa, int32_t amin, int32_t amax,
+                                 int32_t b0, int32_t sb, int32_t bmin, int32_t bmax,
+                                 int32_t da, int32_t db, int32_t *first, int32_t *last)
+{
+    int64_t lo = 0, hi = da - 1;
+    int64_t k0, k1;
+
+    /* major axis moves one a step */
+    if (sa > 0) {
+        lo = MAX(lo, amin - a0);
+        hi = MIN(hi, amax - a0);
+    }
+    else {
+        lo = MAX(lo, a0 - amax);
+        hi = MIN(hi, a0 - amin);
+    }
+
+    /* minor axis moves k(i), which must be in [k0, k1] */
+    if (sb > 0) {
+        k0 = bmin - b0;
+        k1 = bmax - b0;
+    }
+    else {
+        k0 = b0 - bmax;
+        k1 = b0 - bmin;
+    }
+
+    if (k1 < 0) {
+        return 0;
+    }
+
+    if (db == 0) {
+        if (k0 > 0) {
+            return 0;
+        }
+    }
+    else {
+        /* smallest i with k(i) >= k0, largest i with k(i) <= k1 */
+        if (k0 > 0) {
+            lo = MAX(lo, (2 * da * k0 - da + 1 + 2 * db - 1) / (2 * db));
+        }
+        hi = MIN(hi, (2 * da * (k1 + 1) - da + 1 + 2 * db - 1) / (2 * db) - 1);
+    }
+
+    *first = (int32_t)lo;
+    *last  = (int32_t)hi;
+
+    return lo <= hi;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Draw a line by Bresenham
+ * @param[in]  *dc      Using this DC to draw
+ * @param[in]  x1       Start point x
+ * @param[in]  x2       End point x
+ * @param[in]  y1       Start point y
+ * @param[in]  y2       End point y
+ * @param[in]  width    Line width, 1 for thin line
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Thin line is drawn as runs of pixels on major axis, one
+ *             draw_hline or draw_vline a run. Wide line is drawn as one
+ *             span across major axis a step, span is long enough to make
+ *             line width across the line itself.
+ *******************************************************************************
+ */
+static void _gui_dc_line(dc_t *dc, int32_t x1, int32_t x2, int32_t y1, int32_t y2, int32_t width)
+{
+    int32_t dx = ABS(x2 - x1), dy = ABS(y2 - y1);
+    int32_t sx = x2 >= x1 ? 1 : -1, sy = y2 >= y1 ? 1 : -1;
+    int32_t a0, sa, da, b0, sb, db, span = 1, i, first, last, start, a, b, k;
+    int64_t e;
+    bool_t  xmajor = dx >= dy;
+    rect_t  bound;
+
+    gui_dc_get_bound(dc, &bound);
+
+    if (xmajor) {
+        a0 = x1; sa = sx; da = dx;
+        b0 = y1; sb = sy; db = dy;
+    }
+    else {
+        a0 = y1; sa = sy; da = dy;
+        b0 = x1; sb = sx; db = dx;
+    }
+
+    /* span across major axis, steps whose span touches bound are kept */
+    if (width > 1) {
+        span = (int32_t)((width * _gui_dc_sqrt((uint64_t)da * da + (uint64_t)db * db) + da / 2) / da);
+    }
+
+    if (xmajor) {
+        if (!_gui_dc_line_range(a0, sa, bound.x1, bound.x2 - 1, b0, sb,
+                                bound.y1 - span, bound.y2 - 1 + span, da, db, &first, &last))
+            return;
+    }
+    else {
+        if (!_gui_dc_line_range(a0, sa, bound.y1, bound.y2 - 1, b0, sb,
+                                bound.x1 - span, bound.x2 - 1 + span, da, db, &first, &last))
+            return;
+    }
+
+    k = (int32_t)(((int64_t)2 * first * db + da - 1) / (2 * da));
+    e = (int64_t)2 * first * db - (int64_t)2 * da * k;
+
+    for (i = start = first; i <= last; i++) {
+        a = a0 + sa * i;
+        b = b0 + sb * k;
+
+        if (span > 1) {
+            if (xmajor) {
+                dc->engine->draw_vline(dc, a, b - span / 2, b - span / 2 + span);
+            }
+            else {
+                dc->engine->draw_hline(dc, b - span / 2, b - span / 2 + span, a);
+            }
+        }
+
+        e += 2 * db;
+        if (e > da) {
+            k++;
+            e -= 2 * da;
+        }
+        else if (i < last) {
+            continue;
+        }
+
+        /* run of thin line ends at minor axis step */
+        if (span == 1) {
+            if (xmajor) {
+                dc->engine->draw_hline(dc, MIN(a0 + sa * start, a), MAX(a0 + sa * start, a) + 1, b);
+            }
+            else {
+                dc->engine->draw_vline(dc, b, MIN(a0 + sa * start, a), MAX(a0 + sa * start, a) + 1);
+            }
+        }
+        start = i + 1;
+    }
+}
+
 /**
  *******************************************************************************
  * @brief      Draw a line
  * @param[in]  *dc      Using this DC to draw
- * @param[in]  x1       Rectangle coordinate x1
- * @param[in]  x2       Rectangle coordinate x2
- * @param[in]  y1       Rectangle coordinate y1
- * @param[in]  y2       Rectangle coordinate y2
+ * @param[in]  x1       Start point x
+ * @param[in]  x2       End point x
+ * @param[in]  y1       Start point y
+ * @param[in]  y2       End point y
  * @param[out] None
  * @retval     None
+ *
+ * @par Description
+ * @details    End point is not drawn, so lines joined at a point write it
+ *             once. Line is clipped by DC bound before it is stepped.
  *******************************************************************************
  */
 void gui_dc_draw_line(dc_t *dc, int32_t x1, int32_t x2, int32_t y1, int32_t y2)
@@ -31,16 +234,147 @@ void gui_dc_draw_line(dc_t *dc, int32_t x1, int32_t x2, int32_t y1, int32_t y2)
 		dc->engine->draw_vline(dc, x1, y1, y2);    /* this is a line width 1  */
     } else if (y1 == y2) { 
 		dc->engine->draw_hline(dc, x1, x2, y1);    /* this is a line height 1 */
-    } else{        /* this is a line like rectangle                           */              
-		_int_comp(x1, x2);
-		_int_comp(y1, y2);
-		
-		for( ; y1 < y2; y1++) {
-			dc->engine->draw_hline(dc, x1, x2, y1);
-        }
+    } else {
+        _gui_dc_line(dc, x1, x2, y1, y2, 1);
 	}
 }
 
+/**
+ *******************************************************************************
+ * @brief      Draw a wide line
+ * @param[in]  *dc      Using this DC to draw
+ * @param[in]  x1       Start point x
+ * @param[in]  x2       End point x
+ * @param[in]  y1       Start point y
+ * @param[in]  y2       End point y
+ * @param[in]  width    Line width in pixels
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Line is centered on the thin one and its ends are cut
+ *             across major axis.
+ *******************************************************************************
+ */
+void gui_dc_draw_wide_line(dc_t *dc, int32_t x1, int32_t x2, int32_t y1, int32_t y2, int32_t width)
+{
+    rect_t rect;
+
+	ASSERT(dc != Co_NULL);
+
+    if (width <= 1) {
+        gui_dc_draw_line(dc, x1, x2, y1, y2);
+        return;
+    }
+
+    /* straight wide line is a rectangle */
+    if (x1 == x2 || y1 == y2) {
+        rect.x1 = x1 == x2 ? x1 - width / 2 : MIN(x1, x2);
+        rect.x2 = x1 == x2 ? rect.x1 + width : MAX(x1, x2);
+        rect.y1 = y1 == y2 ? y1 - width / 2 : MIN(y1, y2);
+        rect.y2 = y1 == y2 ? rect.y1 + width : MAX(y1, y2);
+        gui_dc_fill_rect_forecolor(dc, &rect);
+        return;
+    }
+
+    _gui_dc_line(dc, x1, x2, y1, y2, width);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Draw an anti-aliased line
+ * @param[in]  *dc      Using this DC to draw
+ * @param[in]  x1       Start point x
+ * @param[in]  x2       End point x
+ * @param[in]  y1       Start point y
+ * @param[in]  y2       End point y
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Xiaolin Wu's line: every step covers two pixels across major
+ *             axis by how near the line passes. Coverage is blended onto
+ *             background color of DC with a 16 entry color table made once
+ *             a line. End point is not drawn.
+ *******************************************************************************
+ */
+void gui_dc_draw_line_aa(dc_t *dc, int32_t x1, int32_t x2, int32_t y1, int32_t y2)
+{
+    int32_t dx = ABS(x2 - x1), dy = ABS(y2 - y1);
+    int32_t a0, sa, da, b0, db, first, last, i, a, b, f;
+    int32_t amin, amax, bmin, bmax;
+    int64_t pos, grad;
+    bool_t  xmajor = dx >= dy;
+    color_t lut[16];
+    rect_t  bound;
+
+	ASSERT(dc != Co_NULL);
+
+    if (dx == 0 || dy == 0) {
+        gui_dc_draw_line(dc, x1, x2, y1, y2);
+        return;
+    }
+
+    for (i = 0; i < 16; i++) {
+        lut[i] = gui_color_blend(GUI_DC_FC(dc), GUI_DC_BC(dc), (uint8_t)(i * 17));
+    }
+
+    gui_dc_get_bound(dc, &bound);
+
+    if (xmajor) {
+        a0 = x1; sa = x2 >= x1 ? 1 : -1; da = dx;
+        b0 = y1; db = y2 - y1;
+        amin = bound.x1; amax = bound.x2 - 1;
+        bmin = bound.y1; bmax = bound.y2 - 1;
+    }
+    else {
+        a0 = y1; sa = y2 >= y1 ? 1 : -1; da = dy;
+        b0 = x1; db = x2 - x1;
+        amin = bound.y1; amax = bound.y2 - 1;
+        bmin = bound.x1; bmax = bound.x2 - 1;
+    }
+
+    /* major axis is cut here, minor axis a pixel */
+    first = 0;
+    last  = da - 1;
+    if (sa > 0) {
+        first = MAX(first, amin - a0);
+        last  = MIN(last, amax - a0);
+    }
+    else {
+        first = MAX(first, a0 - amax);
+        last  = MIN(last, a0 - amin);
+    }
+
+    /* minor axis in 16.16 fixed point */
+    grad = ((int64_t)db << 16) / da;
+    pos  = ((int64_t)b0 << 16) + grad * first;
+
+    for (i = first; i <= last; i++, pos += grad) {
+        a = a0 + sa * i;
+        b = (int32_t)(pos >> 16);
+        f = (int32_t)(pos >> 12) & 0x0F;
+
+        if (b >= bmin && b <= bmax) {
+            if (xmajor) {
+                dc->engine->draw_color_point(dc, a, b, lut[15 - f]);
+            }
+            else {
+                dc->engine->draw_color_point(dc, b, a, lut[15 - f]);
+            }
+        }
+
+        if (f != 0 && b + 1 >= bmin && b + 1 <= bmax) {
+            if (xmajor) {
+                dc->engine->draw_color_point(dc, a, b + 1, lut[f]);
+            }
+            else {
+                dc->engine->draw_color_point(dc, b + 1, a, lut[f]);
+            }
+        }
+    }
+}
+
 /**
  *******************************************************************************
  * @brief      Draw a hollow rectangle
@@ -130,22 +464,640 @@ void gui_dc_draw_border(dc_t *dc, rect_t *rect)
     GUI_DC_FC(dc) = save_color;   /* restore original foreground color      */
 }
 
-void gui_dc_draw_text(dc_t *dc, rect_t *rect, char *str)
+/**
+ *******************************************************************************
+ * @brief      Draw a run of outline pixels on every quadrant
+ * @param[in]  *dc      Using this DC to draw
+ * @param[in]  xl       Center x of left quadrants
+ * @param[in]  xr       Center x of right quadrants
+ * @param[in]  yt       Center y of top quadrants
+ * @param[in]  yb       Center y of bottom quadrants
+ * @param[in]  fixed    Row of a horizontal run, column of a vertical run
+ * @param[in]  a        First pixel of run, distance to center
+ * @param[in]  b        Last pixel of run, distance to center
+ * @param[in]  vertical Run is a column
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Runs of the two sides are joined if they meet, so a run on
+ *             the axis of a rounded rectangle draws its straight edge too.
+ *******************************************************************************
+ */
+static void _gui_dc_quad_run(dc_t *dc, int32_t xl, int32_t xr, int32_t yt, int32_t yb,
+                             int32_t fixed, int32_t a, int32_t b, bool_t vertical)
 {
-	ASSERT(dc != Co_NULL);
+    if (a > b) {
+        return;
+    }
 
-    if (str == Co_NULL) {
-        return;         /* pass if nothing to show                            */
+    if (!vertical) {
+        if (a == 0) {
+            dc->engine->draw_hline(dc, xl - b, xr + b + 1, yt - fixed);
+            if (yt - fixed != yb + fixed) {
+                dc->engine->draw_hline(dc, xl - b, xr + b + 1, yb + fixed);
+            }
+            return;
+        }
+
+        dc->engine->draw_hline(dc, xl - b, xl - a + 1, yt - fixed);
+        dc->engine->draw_hline(dc, xr + a, xr + b + 1, yt - fixed);
+        if (yt - fixed != yb + fixed) {
+            dc->engine->draw_hline(dc, xl - b, xl - a + 1, yb + fixed);
+            dc->engine->draw_hline(dc, xr + a, xr + b + 1, yb + fixed);
+        }
+        return;
     }
 
-    uint16_t text_align = GUI_DC_TA(dc);
-    int16_t  tx, ty;
+    if (a == 0) {
+        dc->engine->draw_vline(dc, xl - fixed, yt - b, yb + b + 1);
+        if (xl - fixed != xr + fixed) {
+            dc->engine->draw_vline(dc, xr + fixed, yt - b, yb + b + 1);
+        }
+        return;
+    }
+
+    dc->engine->draw_vline(dc, xl - fixed, yt - b, yt - a + 1);
+    dc->engine->draw_vline(dc, xl - fixed, yb + a, yb + b + 1);
+    if (xl - fixed != xr + fixed) {
+        dc->engine->draw_vline(dc, xr + fixed, yt - b, yt - a + 1);
+        dc->engine->draw_vline(dc, xr + fixed, yb + a, yb + b + 1);
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Fill a scanline of a round shape on top and bottom half
+ * @param[in]  *dc      Using this DC to draw
+ * @param[in]  xl       Center x of left quadrants
+ * @param[in]  xr       Center x of right quadrants
+ * @param[in]  yt       Center y of top quadrants
+ * @param[in]  yb       Center y of bottom quadrants
+ * @param[in]  dy       Distance of scanline to center
+ * @param[in]  w        Half width of scanline
+ * @param[out] None
+ * @retval     None
+ *******************************************************************************
+ */
+static void _gui_dc_quad_span(dc_t *dc, int32_t xl, int32_t xr, int32_t yt, int32_t yb,
+                              int32_t dy, int32_t w)
+{
+    dc->engine->draw_hline(dc, xl - w, xr + w + 1, yt - dy);
+    if (yt - dy != yb + dy) {
+        dc->engine->draw_hline(dc, xl - w, xr + w + 1, yb + dy);
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Draw or fill quarter circles around a core rectangle
+ * @param[in]  *dc      Using this DC to draw
+ * @param[in]  xl       Center x of left quadrants
+ * @param[in]  xr       Center x of right quadrants
+ * @param[in]  yt       Center y of top quadrants
+ * @param[in]  yb       Center y of bottom quadrants
+ * @param[in]  r        Radius
+ * @param[in]  fill     Fill shape instead of outline
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Midpoint circle steps the first octant only. A run of pixels
+ *             on one row there is the same run on one column of the second
+ *             octant, so outline is drawn as horizontal and vertical runs
+ *             mirrored to every quadrant, and fill as one span a scanline.
+ *             A circle is the case of a core rectangle with no size.
+ *******************************************************************************
+ */
+static void _gui_dc_round(dc_t *dc, int32_t xl, int32_t xr, int32_t yt, int32_t yb,
+                          int32_t r, bool_t fill)
+{
+    int32_t x, y, ny, d, start, i;
+
+    x = 0;
+    y = r;
+    d = 1 - r;
+    start = 0;
+
+    while (x <= y) {
+        ny = y;
+        if (d < 0) {
+            d += 2 * x + 3;
+        }
+        else {
+            d += 2 * (x - y) + 5;
+            ny--;
+        }
+
+        /* run of row y ends here, its mirror leaves the diagonal out */
+        if (ny != y || x + 1 > ny) {
+            if (fill) {
+                _gui_dc_quad_span(dc, xl, xr, yt, yb, y, x);
+                for (i = start; i <= MIN(x, y - 1); i++) {
+                    _gui_dc_quad_span(dc, xl, xr, yt, yb, i, y);
+                }
+            }
+            else {
+                _gui_dc_quad_run(dc, xl, xr, yt, yb, y, start, x, 0);
+                _gui_dc_quad_run(dc, xl, xr, yt, yb, y, start, MIN(x, y - 1), 1);
+            }
+            start = x + 1;
+        }
+
+        x++;
+        y = ny;
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Draw or fill an ellipse
+ * @param[in]  *dc      Using this DC to draw
+ * @param[in]  cx       Center x
+ * @param[in]  cy       Center y
+ * @param[in]  rx       Horizontal radius
+ * @param[in]  ry       Vertical radius
+ * @param[in]  fill     Fill shape instead of outline
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Midpoint ellipse steps x while slope is gentle, so pixels are
+ *             gathered into horizontal runs, then steps y where they are
+ *             gathered into vertical runs. Fill takes one span a scanline.
+ *******************************************************************************
+ */
+static void _gui_dc_ellipse(dc_t *dc, int32_t cx, int32_t cy, int32_t rx, int32_t ry, bool_t fill)
+{
+    int64_t rx2 = (int64_t)rx * rx, ry2 = (int64_t)ry * ry;
+    int64_t px, py, d;
+    int32_t x, y, nx, start;
+
+    /* flat ellipse is a line */
+    if (rx == 0 || ry == 0) {
+        _gui_dc_quad_run(dc, cx, cx, cy, cy, 0, 0, ry == 0 ? rx : ry, ry != 0);
+        return;
+    }
+
+    x = 0;
+    y = ry;
+    px = 0;
+    py = 2 * rx2 * y;
+    start = 0;
+
+    /* region 1, times 4 to keep integer */
+    d = 4 * ry2 - 4 * rx2 * ry + rx2;
+    while (px < py) {
+        x++;
+        px += 2 * ry2;
+
+        if (d < 0) {
+            d += 4 * (px + ry2);
+        }
+        else {
+            if (fill) {
+                _gui_dc_quad_span(dc, cx, cx, cy, cy, y, x - 1);
+            }
+            else {
+                _gui_dc_quad_run(dc, cx, cx, cy, cy, y, start, x - 1, 0);
+            }
+            start = x;
+
+            y--;
+            py -= 2 * rx2;
+            d += 4 * (px - py + ry2);
+        }
+    }
+
+    /* rest of the row goes with region 2, fill takes it there */
+    if (!fill) {
+        _gui_dc_quad_run(dc, cx, cx, cy, cy, y, start, x - 1, 0);
+    }
+
+    /* region 2 */
+    start = y;
+    d = ry2 * (2 * x + 1) * (2 * x + 1) + 4 * rx2 * ((int64_t)(y - 1) * (y - 1) - ry2);
+    while (y >= 0) {
+        if (fill) {
+            _gui_dc_quad_span(dc, cx, cx, cy, cy, y, x);
+        }
+
+        py -= 2 * rx2;
+        if (d > 0) {
+            d += 4 * (rx2 - py);
+            nx = x;
+        }
+        else {
+            px += 2 * ry2;
+            d += 4 * (px - py + rx2);
+            nx = x + 1;
+        }
+
+        /* run of column x ends here */
+        if (nx != x || y == 0) {
+            if (!fill) {
+                _gui_dc_quad_run(dc, cx, cx, cy, cy, x, y, start, 1);
+            }
+            start = y - 1;
+        }
+
+        x = nx;
+        y--;
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Draw a circle
+ * @param[in]  *dc      Using this DC to draw
+ * @param[in]  x        Center x
+ * @param[in]  y        Center y
+ * @param[in]  r        Radius
+ * @param[out] None
+ * @retval     None
+ *******************************************************************************
+ */
+void gui_dc_draw_circle(dc_t *dc, int32_t x, int32_t y, int32_t r)
+{
+    ASSERT(dc != Co_NULL);
+
+    if (r < 0) {
+        return;
+    }
+
+    _gui_dc_round(dc, x, x, y, y, r, 0);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Fill a circle with foreground color
+ * @param[in]  *dc      Using this DC to draw
+ * @param[in]  x        Center x
+ * @param[in]  y        Center y
+ * @param[in]  r        Radius
+ * @param[out] None
+ * @retval     None
+ *******************************************************************************
+ */
+void gui_dc_fill_circle(dc_t *dc, int32_t x, int32_t y, int32_t r)
+{
+    ASSERT(dc != Co_NULL);
+
+    if (r < 0) {
+        return;
+    }
+
+    _gui_dc_round(dc, x, x, y, y, r, 1);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Draw an ellipse
+ * @param[in]  *dc      Using this DC to draw
+ * @param[in]  x        Center x
+ * @param[in]  y        Center y
+ * @param[in]  rx       Horizontal radius
+ * @param[in]  ry       Vertical radius
+ * @param[out] None
+ * @retval     None
+ *******************************************************************************
+ */
+void gui_dc_draw_ellipse(dc_t *dc, int32_t x, int32_t y, int32_t rx, int32_t ry)
+{
+    ASSERT(dc != Co_NULL);
+
+    if (rx < 0 || ry < 0) {
+        return;
+    }
+
+    _gui_dc_ellipse(dc, x, y, rx, ry, 0);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Fill an ellipse with foreground color
+ * @param[in]  *dc      Using this DC to draw
+ * @param[in]  x        Center x
+ * @param[in]  y        Center y
+ * @param[in]  rx       Horizontal radius
+ * @param[in]  ry       Vertical radius
+ * @param[out] None
+ * @retval     None
+ *******************************************************************************
+ */
+void gui_dc_fill_ellipse(dc_t *dc, int32_t x, int32_t y, int32_t rx, int32_t ry)
+{
+    ASSERT(dc != Co_NULL);
+
+    if (rx < 0 || ry < 0) {
+        return;
+    }
+
+    _gui_dc_ellipse(dc, x, y, rx, ry, 1);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Draw a rectangle with round corners
+ * @param[in]  *dc      Using this DC to draw
+ * @param[in]  *rect    Draw this rectangle
+ * @param[in]  r        Corner radius, cut to half of shorter side
+ * @param[out] None
+ * @retval     None
+ *******************************************************************************
+ */
+void gui_dc_draw_round_rect(dc_t *dc, rect_t *rect, int32_t r)
+{
+    ASSERT(dc != Co_NULL);
+
+    if (rect == Co_NULL || GUI_RECT_IS_EMPTY(rect)) {
+        return;
+    }
+
+    r = MIN(r, (MIN(GUI_RECT_WIDTH(rect), GUI_RECT_HEIGHT(rect)) - 1) / 2);
+    if (r <= 0) {
+        gui_dc_draw_rect(dc, rect);
+        return;
+    }
+
+    _gui_dc_round(dc, rect->x1 + r, rect->x2 - 1 - r, rect->y1 + r, rect->y2 - 1 - r, r, 0);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Fill a rectangle with round corners with foreground color
+ * @param[in]  *dc      Using this DC to draw
+ * @param[in]  *rect    Fill this rectangle
+ * @param[in]  r        Corner radius, cut to half of shorter side
+ * @param[out] None
+ * @retval     None
+ *******************************************************************************
+ */
+void gui_dc_fill_round_rect(dc_t *dc, rect_t *rect, int32_t r)
+{
+    rect_t middle;
+
+    ASSERT(dc != Co_NULL);
+
+    if (rect == Co_NULL || GUI_RECT_IS_EMPTY(rect)) {
+        return;
+    }
+
+    r = MIN(r, (MIN(GUI_RECT_WIDTH(rect), GUI_RECT_HEIGHT(rect)) - 1) / 2);
+    if (r <= 0) {
+        gui_dc_fill_rect_forecolor(dc, rect);
+        return;
+    }
+
+    _gui_dc_round(dc, rect->x1 + r, rect->x2 - 1 - r, rect->y1 + r, rect->y2 - 1 - r, r, 1);
+
+    /* rows between corners are one block */
+    middle = *rect;
+    middle.y1 = rect->y1 + r + 1;
+    middle.y2 = rect->y2 - 1 - r;
+    if (!GUI_RECT_IS_EMPTY(&middle)) {
+        gui_dc_fill_rect_forecolor(dc, &middle);
+    }
+}
+
+/**
+ * @struct   poly_edge dc.c
+ * @brief    Polygon edge struct
+ * @details  This struct is one edge of polygon in scanline fill. Where edge
+ *           crosses center of a row is kept as the first pixel on its
+ *           right and an error term, so x moves by integer math only.
+ */
+struct poly_edge
+{
+    struct poly_edge *next;     /**< next edge starting on same row      */
+    int32_t           y2;       /**< first row under the edge            */
+    int32_t           x;        /**< first pixel right of crossing       */
+    int32_t           err;      /**< x * den minus crossing * den        */
+    int32_t           den;      /**< two times edge height               */
+    int32_t           step;     /**< whole pixels x moves a row          */
+    int32_t           rest;     /**< part of den x moves a row           */
+    int32_t           dir;      /**< 1 for edge going down, -1 for up    */
+};
+
+/**
+ *******************************************************************************
+ * @brief      Fill a polygon with foreground color
+ * @param[in]  *dc      Using this DC to draw
+ * @param[in]  *points  Vertices of polygon
+ * @param[in]  count    Number of vertices, last one is joined to first one
+ * @param[in]  rule     GUI_FILL_EVEN_ODD or GUI_FILL_NON_ZERO
+ * @param[out] None
+ * @retval     GUI_E_OK     Polygon is filled.
+ * @retval     GUI_E_ERROR  No memory for edge table.
+ *
+ * @par Description
+ * @details    Edges are put in an edge table by the first row they cross
+ *             inside DC bound, and moved to active edge table row by row.
+ *             A pixel is filled when its center is inside polygon, so
+ *             polygons sharing an edge never write a pixel twice. Rows and
+ *             spans are clipped by DC bound, each span is one draw_hline.
+ *******************************************************************************
+ */
+StatusType gui_dc_fill_polygon(dc_t *dc, const point_t *points, int32_t count, uint8_t rule)
+{
+    struct poly_edge *edges, *e, **table, **active;
+    int32_t i, j, n, y, ystart, yend, xa, ya, xb, yb, dx, dy, xl, wind;
+    int64_t num, q;
+    bool_t  inside;
+    rect_t  bound;
+
+    ASSERT(dc != Co_NULL);
+
+    if (points == Co_NULL || count < 3) {
+        return GUI_E_OK;
+    }
+
+    gui_dc_get_bound(dc, &bound);
+
+    ystart = points[0].y;
+    yend   = points[0].y;
+    for (i = 1; i < count; i++) {
+        ystart = MIN(ystart, points[i].y);
+        yend   = MAX(yend, points[i].y);
+    }
+    ystart = MAX(ystart, bound.y1);
+    yend   = MIN(yend, bound.y2);
+    if (ystart >= yend || bound.x1 >= bound.x2) {
+        return GUI_E_OK;
+    }
+
+    edges = gui_malloc(count * (sizeof(struct poly_edge) + sizeof(struct poly_edge *)) +
+                       (yend - ystart) * sizeof(struct poly_edge *));
+    if (edges == Co_NULL) {
+        return GUI_E_ERROR;
+    }
+    active = (struct poly_edge **)(edges + count);
+    table  = active + count;
+    gui_memset(table, 0, (yend - ystart) * sizeof(struct poly_edge *));
+
+    /* build edge table, flat edges and edges out of bound are dropped */
+    for (i = 0; i < count; i++) {
+        e  = &edges[i];
+        xa = points[i].x;
+        ya = points[i].y;
+        xb = points[(i + 1) % count].x;
+        yb = points[(i + 1) % count].y;
+
+        e->dir = 1;
+        if (ya > yb) {
+            _int_swap(xa, xb);
+            _int_swap(ya, yb);
+            e->dir = -1;
+        }
+        if (ya == yb || yb <= ystart || ya >= yend) {
+            continue;
+        }
+
+        dx = xb - xa;
+        dy = yb - ya;
+        y  = MAX(ya, ystart);
+
+        /* crossing of row y is xa + (2 (y - ya) + 1) dx / 2 dy */
+        e->y2   = yb;
+        e->den  = 2 * dy;
+        num     = (int64_t)e->den * xa + (int64_t)(2 * (y - ya) + 1) * dx - dy;
+        q       = num / e->den;
+        if (q * e->den < num) {
+            q++;
+        }
+        e->x    = (int32_t)q;
+        e->err  = (int32_t)(q * e->den - num);
+        e->step = (2 * dx) / e->den;
+        if (e->step * e->den > 2 * dx) {
+            e->step--;
+        }
+        e->rest = 2 * dx - e->step * e->den;
+
+        e->next = table[y - ystart];
+        table[y - ystart] = e;
+    }
+
+    n = 0;
+    for (y = ystart; y < yend; y++) {
+        for (e = table[y - ystart]; e != Co_NULL; e = e->next) {
+            active[n++] = e;
+        }
+
+        /* active edges move a little a row, so insertion sort is short */
+        for (i = 1; i < n; i++) {
+            e = active[i];
+            for (j = i; j > 0 && active[j - 1]->x > e->x; j--) {
+                active[j] = active[j - 1];
+            }
+            active[j] = e;
+        }
+
+        /* span starts where polygon is entered and ends where it is left */
+        wind   = 0;
+        inside = 0;
+        xl     = 0;
+        for (i = 0; i < n; i++) {
+            wind += (rule == GUI_FILL_NON_ZERO) ? active[i]->dir : 1;
+            if (!inside) {
+                xl = active[i]->x;
+            }
+            inside = (rule == GUI_FILL_NON_ZERO) ? (wind != 0) : (wind & 1);
+            if (!inside) {
+                xl = MAX(xl, bound.x1);
+                if (xl < MIN(active[i]->x, bound.x2)) {
+                    dc->engine->draw_hline(dc, xl, MIN(active[i]->x, bound.x2), y);
+                }
+            }
+        }
 
-    /* default style setting */
-    if (text_align == GUI_TEXT_ALIGN_NONE) {
-        tx = ty = 0;
+        /* drop finished edges and step the others to next row */
+        for (i = j = 0; i < n; i++) {
+            e = active[i];
+            if (y + 1 >= e->y2) {
+                continue;
+            }
+            e->x   += e->step;
+            e->err -= e->rest;
+            if (e->err < 0) {
+                e->x++;
+                e->err += e->den;
+            }
+            active[j++] = e;
+        }
+        n = j;
     }
 
+    gui_free(edges);
+
+    return GUI_E_OK;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Draw lines through points
+ * @param[in]  *dc      Using this DC to draw
+ * @param[in]  *points  Points to join
+ * @param[in]  count    Number of points
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Every segment leaves its end point to the next one, so each
+ *             vertex is written once. Last point is not drawn, repeat first
+ *             point at the end to close the lines.
+ *******************************************************************************
+ */
+void gui_dc_draw_polyline(dc_t *dc, const point_t *points, int32_t count)
+{
+    int32_t i, x1, x2, y1, y2;
+
+    ASSERT(dc != Co_NULL);
+
+    if (points == Co_NULL) {
+        return;
+    }
+
+    for (i = 1; i < count; i++) {
+        x1 = points[i - 1].x;
+        y1 = points[i - 1].y;
+        x2 = points[i].x;
+        y2 = points[i].y;
+
+        if (x1 == x2 && y1 == y2) {
+            continue;
+        }
+
+        /* straight line going back keeps start point and leaves end point */
+        if (y1 == y2 && x2 < x1) {
+            dc->engine->draw_hline(dc, x2 + 1, x1 + 1, y1);
+        }
+        else if (x1 == x2 && y2 < y1) {
+            dc->engine->draw_vline(dc, x1, y2 + 1, y1 + 1);
+        }
+        else {
+            gui_dc_draw_line(dc, x1, x2, y1, y2);
+        }
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Get where text starts in a rectangle
+ * @param[in]  *dc      DC whose font and text align are used
+ * @param[in]  *rect    Rectangle text is put in
+ * @param[in]  *str     Text to put
+ * @param[out] *origin  Start point of text, relative to rectangle
+ * @retval     None
+ *******************************************************************************
+ */
+void gui_dc_get_text_origin(dc_t *dc, rect_t *rect, char *str, point_t *origin)
+{
+	ASSERT(dc != Co_NULL);
+	ASSERT(origin != Co_NULL);
+
+    uint16_t text_align = GUI_DC_TA(dc);
+    int16_t  tx = 0, ty = 0;
+
     uint32_t text_width = gui_get_text_width(str, GUI_DC_FONT(dc));
     uint32_t rect_width = GUI_RECT_WIDTH(rect);
 
@@ -186,8 +1138,24 @@ void gui_dc_draw_text(dc_t *dc, rect_t *rect, char *str)
         ty = rect_height - text_height;
     }
 
+    origin->x = tx;
+    origin->y = ty;
+}
+
+void gui_dc_draw_text(dc_t *dc, rect_t *rect, char *str)
+{
+	ASSERT(dc != Co_NULL);
+
+    if (str == Co_NULL) {
+        return;         /* pass if nothing to show                            */
+    }
+
+    point_t origin;
+
+    gui_dc_get_text_origin(dc, rect, str, &origin);
+
     /* put text in the right place */
-    gui_lcd_puts(tx+rect->x1, ty+rect->y1, str, GUI_DC_FONT(dc), dc, rect);
+    gui_lcd_puts(origin.x+rect->x1, origin.y+rect->y1, str, GUI_DC_FONT(dc), dc, rect);
 }
 
 /**
@@ -226,6 +1194,110 @@ struct gc *gui_dc_get_gc(dc_t *dc)
 	return gc;
 }
 
+/**
+ *******************************************************************************
+ * @brief      Move pixels inside DC
+ * @param[in]  *dc      Using this DC to copy
+ * @param[in]  *rect    Logic rectangle to move
+ * @param[in]  dx       Distance to move on x axis
+ * @param[in]  dy       Distance to move on y axis
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    This function is called to scroll content already drawn, so
+ *             only the newly exposed part needs to be drawn again. Pixels
+ *             moved out of DC bound are dropped.
+ *******************************************************************************
+ */
+void gui_dc_copy_area(dc_t *dc, rect_t *rect, int32_t dx, int32_t dy)
+{
+	ASSERT(dc != Co_NULL);
+
+	if (rect == Co_NULL || (dx == 0 && dy == 0)) {
+		return;
+	}
+
+	dc->engine->copy_area(dc, rect, dx, dy);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Get where drawing of DC can reach
+ * @param[in]  *dc      Which DC to get
+ * @param[out] *bound   Logic rectangle of DC owner cut by clip
+ * @retval     None
+ *
+ * @par Description
+ * @details    This function is called to clip shapes before they are
+ *             rasterized, so nothing out of it is stepped at all.
+ *******************************************************************************
+ */
+void gui_dc_get_bound(dc_t *dc, rect_t *bound)
+{
+	ASSERT(dc != Co_NULL);
+	ASSERT(bound != Co_NULL);
+
+	switch(dc->type) {
+		case GUI_DC_HW: {
+			struct dc_hw_t *dchw;
+			rect_t *extent;
+			dchw   = (struct dc_hw_t *)dc;
+			extent = &dchw->owner->extent;
+
+			gui_widget_update_extent(dchw->owner);
+
+			bound->x1 = MAX(extent->x1, dchw->clip.x1) - extent->x1;
+			bound->x2 = MIN(extent->x2, dchw->clip.x2) - extent->x1;
+			bound->y1 = MAX(extent->y1, dchw->clip.y1) - extent->y1;
+			bound->y2 = MIN(extent->y2, dchw->clip.y2) - extent->y1;
+			break;
+		}
+
+		default:
+			GUI_SET_RECT(bound, 0, 0, COGUI_SCREEN_WIDTH, COGUI_SCREEN_HEIGHT);
+			break;
+	}
+}
+
+/**
+ *******************************************************************************
+ * @brief      Set clip rectangle of DC
+ * @param[in]  *dc      Which DC to set
+ * @param[in]  *rect    Physical clip rectangle, Co_NULL for no limit
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    This function is called to limit all drawing of DC inside a
+ *             physical rectangle, which is used to paint the visible part of
+ *             a widget only.
+ *******************************************************************************
+ */
+void gui_dc_set_clip(dc_t *dc, rect_t *rect)
+{
+	ASSERT(dc != Co_NULL);
+
+	switch(dc->type) {
+		case GUI_DC_HW: {
+			struct dc_hw_t *dchw;
+			dchw = (struct dc_hw_t *)dc;
+
+			if (rect != Co_NULL) {
+				dchw->clip = *rect;
+			}
+			else {
+				GUI_SET_RECT(&dchw->clip, 0, 0, COGUI_SCREEN_WIDTH, COGUI_SCREEN_HEIGHT);
+			}
+			break;
+		}
+
+		case GUI_DC_BUFFER:
+		default:
+			break;
+	}
+}
+
 /**
  *******************************************************************************
  * @brief      Get DC's owner
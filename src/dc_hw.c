@@ -14,6 +14,13 @@ static void dc_hw_draw_color_point(dc_t *dc, int32_t x, int32_t y, color_t color
 static void dc_hw_draw_vline(dc_t *dc, int32_t x, int32_t y1, int32_t y2);
 static void dc_hw_draw_hline(dc_t *dc, int32_t x1, int32_t x2, int32_t y);
 static void dc_hw_fill_rect(dc_t *dc, rect_t *rect);
+static void dc_hw_copy_area(dc_t *dc, rect_t *rect, int32_t dx, int32_t dy);
+static void dc_hw_draw_glyph(dc_t *dc, int32_t x, int32_t y, int32_t left, int32_t width,
+                             int32_t height, const uint16_t *bits, bool_t opaque);
+static void dc_hw_draw_indexed(dc_t *dc, int32_t x, int32_t y, int32_t width, int32_t height,
+                               const uint8_t *index, const color_t *palette, int32_t key);
+static void dc_hw_draw_pixels(dc_t *dc, int32_t x, int32_t y, int32_t width,
+                              const void *pixels, int32_t count);
 static StatusType dc_hw_fini(dc_t *dc);
 
 struct dc_engine dc_hw_engine =
@@ -23,6 +30,10 @@ struct dc_engine dc_hw_engine =
     dc_hw_draw_vline,
     dc_hw_draw_hline,
     dc_hw_fill_rect,
+    dc_hw_copy_area,
+    dc_hw_draw_glyph,
+    dc_hw_draw_indexed,
+    dc_hw_draw_pixels,
 
     dc_hw_fini,
 };
@@ -48,6 +59,9 @@ dc_t *dc_hw_create(widget_t *owner)
         dc->parent.engine = &dc_hw_engine;
         dc->owner = owner;
         dc->hw_driver = gui_graphic_driver_get_default();
+
+        /* no clip limit by default */
+        GUI_SET_RECT(&dc->clip, 0, 0, COGUI_SCREEN_WIDTH, COGUI_SCREEN_HEIGHT);
 		
         return (dc_t *)dc;
     }
@@ -75,6 +89,73 @@ static StatusType dc_hw_fini(dc_t *dc)
     return GUI_E_OK;
 }
 
+/**
+ *******************************************************************************
+ * @brief      Get physical drawing bound of hardware DC
+ * @param[in]  *dc          Which DC we used
+ * @param[out] *bound       Owner extent limited by DC clip rectangle
+ * @retval     None
+ *******************************************************************************
+ */
+static void dc_hw_get_bound(struct dc_hw_t *dc, rect_t *bound)
+{
+    rect_t *extent = &dc->owner->extent;
+
+    /* child widget may be moved along with its container */
+    gui_widget_update_extent(dc->owner);
+
+    /* window with backing store is drawn into its store */
+    dc->hw_driver = gui_graphic_driver_get_default();
+
+    bound->x1 = MAX(extent->x1, dc->clip.x1);
+    bound->x2 = MIN(extent->x2, dc->clip.x2);
+    bound->y1 = MAX(extent->y1, dc->clip.y1);
+    bound->y2 = MIN(extent->y2, dc->clip.y2);
+}
+
+/* drawing of DC is blended onto screen */
+#define DC_HW_IS_BLENDED(dc)    ((dc)->owner->gc.blend != GUI_BLEND_NONE && (dc)->owner->gc.alpha != 255)
+
+/**
+ *******************************************************************************
+ * @brief      Draw a physical horizontal line by blend mode of hardware DC
+ * @param[in]  *dc          Which DC we used
+ * @param[in]  *c           Color of line
+ * @param[in]  x1           Coordinate x1
+ * @param[in]  x2           Coordinate x2, not drawn
+ * @param[in]  y            Coordinate y
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Blended line is given to driver as a whole. Only if driver
+ *             can not blend, pixels are read back and blended one by one.
+ *******************************************************************************
+ */
+static void dc_hw_hline(struct dc_hw_t *dc, color_t *c, int32_t x1, int32_t x2, int32_t y)
+{
+    const struct graphic_driver_ops *ops = dc->hw_driver->ops;
+    uint8_t alpha = dc->owner->gc.alpha;
+    color_t pixel;
+
+    if (!DC_HW_IS_BLENDED(dc)) {
+        ops->draw_hline(c, x1, x2, y);
+    }
+    else if (alpha == 0) {
+        return;
+    }
+    else if (ops->blend_hline != Co_NULL) {
+        ops->blend_hline(c, alpha, x1, x2, y);
+    }
+    else {
+        for (; x1 < x2; x1++) {
+            ops->get_pixel(&pixel, x1, y);
+            pixel = gui_color_blend(*c, pixel, alpha);
+            ops->set_pixel(&pixel, x1, y);
+        }
+    }
+}
+
 /**
  *******************************************************************************
  * @brief      Draw a point through hardware DC 
@@ -88,6 +169,7 @@ static StatusType dc_hw_fini(dc_t *dc)
 static void dc_hw_draw_point(dc_t *self, int32_t x, int32_t y)
 {
     struct dc_hw_t *dc;
+    rect_t bound;
 
     ASSERT(self != Co_NULL);
     dc = (struct dc_hw_t *) self;
@@ -96,18 +178,23 @@ static void dc_hw_draw_point(dc_t *self, int32_t x, int32_t y)
     if (x < 0 || y < 0)
         return;
 
+    dc_hw_get_bound(dc, &bound);
+
     /* move x to logic x */
     x = x + dc->owner->extent.x1;
-    if (x >= dc->owner->extent.x2) 
+    if (x < bound.x1 || x >= bound.x2) 
         return;
     
     /* move y to logic y */
     y = y + dc->owner->extent.y1;
-    if (y >= dc->owner->extent.y2) 
+    if (y < bound.y1 || y >= bound.y2) 
         return;
 
     /* draw this point */
-    dc->hw_driver->ops->set_pixel(&(dc->owner->gc.foreground), x, y);
+    if (DC_HW_IS_BLENDED(dc))
+        dc_hw_hline(dc, &(dc->owner->gc.foreground), x, x + 1, y);
+    else
+        dc->hw_driver->ops->set_pixel(&(dc->owner->gc.foreground), x, y);
 }
 
 /**
@@ -124,6 +211,7 @@ static void dc_hw_draw_point(dc_t *self, int32_t x, int32_t y)
 static void dc_hw_draw_color_point(dc_t *self, int32_t x, int32_t y, color_t color)
 {
     struct dc_hw_t *dc;
+    rect_t bound;
 
     ASSERT(self != Co_NULL);
     dc = (struct dc_hw_t *) self;
@@ -132,18 +220,23 @@ static void dc_hw_draw_color_point(dc_t *self, int32_t x, int32_t y, color_t col
     if (x < 0 || y < 0)
         return;
 
+    dc_hw_get_bound(dc, &bound);
+
     /* move x to logic x */
     x = x + dc->owner->extent.x1;
-    if (x >= dc->owner->extent.x2)
+    if (x < bound.x1 || x >= bound.x2)
         return;
     
     /* move y to logic y */
     y = y + dc->owner->extent.y1;
-    if (y >= dc->owner->extent.y2)
+    if (y < bound.y1 || y >= bound.y2)
         return;
     
     /* draw this point */
-    dc->hw_driver->ops->set_pixel(&color, x, y);
+    if (DC_HW_IS_BLENDED(dc))
+        dc_hw_hline(dc, &color, x, x + 1, y);
+    else
+        dc->hw_driver->ops->set_pixel(&color, x, y);
 }
 
 /**
@@ -164,6 +257,7 @@ static void dc_hw_draw_color_point(dc_t *self, int32_t x, int32_t y, color_t col
 static void dc_hw_draw_vline(dc_t *self, int32_t x, int32_t y1, int32_t y2)
 {
     struct dc_hw_t *dc;
+    rect_t bound;
 
     ASSERT(self != Co_NULL);
     dc = (struct dc_hw_t *) self;
@@ -172,9 +266,11 @@ static void dc_hw_draw_vline(dc_t *self, int32_t x, int32_t y1, int32_t y2)
     if (x < 0)
         return;
 
+    dc_hw_get_bound(dc, &bound);
+
     /* move x to logic x */
     x = x + dc->owner->extent.x1;
-    if (x >= dc->owner->extent.x2)
+    if (x < bound.x1 || x >= bound.x2)
         return;
 
     /* move y1 and y2 to logic */    
@@ -185,19 +281,26 @@ static void dc_hw_draw_vline(dc_t *self, int32_t x, int32_t y1, int32_t y2)
     if (y1 > y2)
         _int_swap(y1, y2);
     
+    /* if the line is over bound, cut it */
+    if (y1 < bound.y1)
+        y1 = bound.y1;
+    
+    if (y2 > bound.y2)
+        y2 = bound.y2;
+
     /* determine y1 and y2 are vaild or not */
-    if (y1 > dc->owner->extent.y2 || y2 < dc->owner->extent.y1)
+    if (y1 >= y2)
         return;
 
-    /* if the line is over extent, cut it */
-    if (y1 < dc->owner->extent.y1)
-        y1 = dc->owner->extent.y1;
-    
-    if (y2 > dc->owner->extent.y2)
-        y2 = dc->owner->extent.y2;
-
-    /* draw this line */
-    dc->hw_driver->ops->draw_vline(&(dc->owner->gc.foreground), x, y1, y2);
+    /* draw this line, blended one a row */
+    if (DC_HW_IS_BLENDED(dc)) {
+        for (; y1 < y2; y1++) {
+            dc_hw_hline(dc, &(dc->owner->gc.foreground), x, x + 1, y1);
+        }
+    }
+    else {
+        dc->hw_driver->ops->draw_vline(&(dc->owner->gc.foreground), x, y1, y2);
+    }
 }
 
 /**
@@ -218,6 +321,7 @@ static void dc_hw_draw_vline(dc_t *self, int32_t x, int32_t y1, int32_t y2)
 static void dc_hw_draw_hline(dc_t *self, int32_t x1, int32_t x2, int32_t y)
 {
     struct dc_hw_t *dc;
+    rect_t bound;
 
     ASSERT(self != Co_NULL);
     dc = (struct dc_hw_t *) self;
@@ -225,10 +329,12 @@ static void dc_hw_draw_hline(dc_t *self, int32_t x1, int32_t x2, int32_t y)
     /* determine y is vaild or not */
     if (y < 0)
         return;
+
+    dc_hw_get_bound(dc, &bound);
     
     /* move y to logic y */
     y = y + dc->owner->extent.y1;
-    if (y >= dc->owner->extent.y2)
+    if (y < bound.y1 || y >= bound.y2)
         return;
 
     /* move x1 and x2 to logic */    
@@ -239,19 +345,19 @@ static void dc_hw_draw_hline(dc_t *self, int32_t x1, int32_t x2, int32_t y)
     if (x1 > x2)
         _int_swap(x1, x2);
     
+    /* if the line is over bound, cut it */
+    if (x1 < bound.x1)
+        x1 = bound.x1;
+    
+    if (x2 > bound.x2)
+        x2 = bound.x2;
+
     /* determine x1 and x2 are vaild or not */
-    if (x1 > dc->owner->extent.x2 || x2 < dc->owner->extent.x1)
+    if (x1 >= x2)
         return;
 
-    /* if the line is over extent, cut it */
-    if (x1 < dc->owner->extent.x1)
-        x1 = dc->owner->extent.x1;
-    
-    if (x2 > dc->owner->extent.x2)
-        x2 = dc->owner->extent.x2;
-
     /* draw this line */
-    dc->hw_driver->ops->draw_hline(&(dc->owner->gc.foreground), x1, x2, y);
+    dc_hw_hline(dc, &(dc->owner->gc.foreground), x1, x2, y);
 }
 
 /**
@@ -272,6 +378,7 @@ static void dc_hw_fill_rect(dc_t *self, rect_t *rect)
     color_t color;
     int32_t y1, y2, x1, x2;
     struct dc_hw_t *dc;
+    rect_t bound;
 
     ASSERT(rect);
     ASSERT(self != Co_NULL);
@@ -280,38 +387,263 @@ static void dc_hw_fill_rect(dc_t *self, rect_t *rect)
     /* get background color */
     color = dc->owner->gc.background;
 
-    /* move to logic position */
-    x1 = rect->x1 + dc->owner->extent.x1;
-    if (x1 > dc->owner->extent.x2)
-        return;
-    
-    if (x1 < dc->owner->extent.x1)
-        x1 = dc->owner->extent.x1;
-    
-    x2 = rect->x2 + dc->owner->extent.x1;
-    if (x2 < dc->owner->extent.x1)
-        return;
-    
-    if (x2 > dc->owner->extent.x2)
-        x2 = dc->owner->extent.x2;        
-    
+    dc_hw_get_bound(dc, &bound);
 
-    y1 = rect->y1 + dc->owner->extent.y1;
-    if (y1 > dc->owner->extent.y2)
+    /* move to logic position and cut by bound */
+    x1 = MAX(rect->x1 + dc->owner->extent.x1, bound.x1);
+    x2 = MIN(rect->x2 + dc->owner->extent.x1, bound.x2);
+    if (x1 >= x2)
         return;
-    
-    if (y1 < dc->owner->extent.y1)
-        y1 = dc->owner->extent.y1;
-    
-    y2 = rect->y2 + dc->owner->extent.y1;
-    if (y2 < dc->owner->extent.y1)
+
+    y1 = MAX(rect->y1 + dc->owner->extent.y1, bound.y1);
+    y2 = MIN(rect->y2 + dc->owner->extent.y1, bound.y2);
+    if (y1 >= y2)
         return;
     
-    if (y2 > dc->owner->extent.y2)
-        y2 = dc->owner->extent.y2;
-    
     /* fille rectangle */
     for (; y1 < y2; y1++) {
-        dc->hw_driver->ops->draw_hline(&color, x1, x2, y1);
+        dc_hw_hline(dc, &color, x1, x2, y1);
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Move pixels through hardware DC
+ * @param[in]  *self        Which DC we used
+ * @param[in]  *rect        Logic rectangle to move
+ * @param[in]  dx           Distance to move on x axis
+ * @param[in]  dy           Distance to move on y axis
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Both source and destination are cut by bound. Driver copy is
+ *             used if it has one, otherwise framebuffer memory is moved.
+ *******************************************************************************
+ */
+static void dc_hw_copy_area(dc_t *self, rect_t *rect, int32_t dx, int32_t dy)
+{
+    struct dc_hw_t *dc;
+    rect_t bound, src, dst;
+
+    ASSERT(rect);
+    ASSERT(self != Co_NULL);
+    dc = (struct dc_hw_t *) self;
+
+    dc_hw_get_bound(dc, &bound);
+
+    /* move to logic position and cut by bound */
+    src.x1 = rect->x1 + dc->owner->extent.x1;
+    src.x2 = rect->x2 + dc->owner->extent.x1;
+    src.y1 = rect->y1 + dc->owner->extent.y1;
+    src.y2 = rect->y2 + dc->owner->extent.y1;
+    if (!gui_rect_intersect(&src, &bound, &src))
+        return;
+
+    /* pixels moved out of bound are dropped */
+    dst.x1 = src.x1 + dx;
+    dst.x2 = src.x2 + dx;
+    dst.y1 = src.y1 + dy;
+    dst.y2 = src.y2 + dy;
+    if (!gui_rect_intersect(&dst, &bound, &dst))
+        return;
+
+    src.x1 = dst.x1 - dx;
+    src.x2 = dst.x2 - dx;
+    src.y1 = dst.y1 - dy;
+    src.y2 = dst.y2 - dy;
+
+    if (dc->hw_driver->ops->copy_area != Co_NULL) {
+        dc->hw_driver->ops->copy_area(&src, dx, dy);
+    }
+    else {
+        gui_framebuffer_move_rect(dc->hw_driver, &src, dx, dy);
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Draw a glyph through hardware DC
+ * @param[in]  *self        Which DC we used
+ * @param[in]  x            Logic x of glyph
+ * @param[in]  y            Logic y of glyph
+ * @param[in]  left         First bitmap column to draw
+ * @param[in]  width        Bitmap columns to draw, left + width is 16 at most
+ * @param[in]  height       Glyph height
+ * @param[in]  *bits        One word a row, left pixel on the highest bit
+ * @param[in]  opaque       Draw unset pixels with background
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Each row is drawn as runs of the same colour, so bound is got
+ *             once a glyph and every pixel is written at most once.
+ *******************************************************************************
+ */
+static void dc_hw_draw_glyph(dc_t *self, int32_t x, int32_t y, int32_t left, int32_t width,
+                             int32_t height, const uint16_t *bits, bool_t opaque)
+{
+    struct dc_hw_t *dc;
+    color_t fc, bc;
+    int32_t i, i2, j, j1, j2, k;
+    uint16_t line, bit;
+    rect_t bound;
+
+    ASSERT(bits);
+    ASSERT(self != Co_NULL);
+    dc = (struct dc_hw_t *) self;
+
+    dc_hw_get_bound(dc, &bound);
+
+    /* move to logic position and cut by bound */
+    x = x + dc->owner->extent.x1;
+    y = y + dc->owner->extent.y1;
+
+    i  = MAX(bound.y1 - y, 0);
+    i2 = MIN(bound.y2 - y, height);
+    j1 = MAX(bound.x1 - x, 0);
+    j2 = MIN(bound.x2 - x, width);
+    if (i >= i2 || j1 >= j2)
+        return;
+
+    fc = dc->owner->gc.foreground;
+    bc = dc->owner->gc.background;
+
+    for (; i < i2; i++) {
+        line = bits[i] << left;
+
+        for (j = j1; j < j2; j = k) {
+            bit = (line << j) & 0x8000;
+
+            /* pixels with the same bit */
+            for (k = j + 1; k < j2 && ((line << k) & 0x8000) == bit; k++);
+
+            if (bit) {
+                dc_hw_hline(dc, &fc, x + j, x + k, y + i);
+            }
+            else if (opaque) {
+                dc_hw_hline(dc, &bc, x + j, x + k, y + i);
+            }
+        }
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Draw indexed pixels through hardware DC
+ * @param[in]  *self        Which DC we used
+ * @param[in]  x            Logic x of pixels
+ * @param[in]  y            Logic y of pixels
+ * @param[in]  width        Pixels a row
+ * @param[in]  height       How many rows
+ * @param[in]  *index       One byte a pixel, row by row
+ * @param[in]  *palette     Color of every index
+ * @param[in]  key          Index not drawn, -1 to draw all
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Each row is drawn as runs of the same index, so color is
+ *             looked up once a run.
+ *******************************************************************************
+ */
+static void dc_hw_draw_indexed(dc_t *self, int32_t x, int32_t y, int32_t width, int32_t height,
+                               const uint8_t *index, const color_t *palette, int32_t key)
+{
+    struct dc_hw_t *dc;
+    int32_t i, i2, j, j1, j2, k;
+    const uint8_t *row;
+    rect_t bound;
+
+    ASSERT(index && palette);
+    ASSERT(self != Co_NULL);
+    dc = (struct dc_hw_t *) self;
+
+    dc_hw_get_bound(dc, &bound);
+
+    /* move to logic position and cut by bound */
+    x = x + dc->owner->extent.x1;
+    y = y + dc->owner->extent.y1;
+
+    i  = MAX(bound.y1 - y, 0);
+    i2 = MIN(bound.y2 - y, height);
+    j1 = MAX(bound.x1 - x, 0);
+    j2 = MIN(bound.x2 - x, width);
+    if (i >= i2 || j1 >= j2)
+        return;
+
+    for (; i < i2; i++) {
+        row = &index[i * width];
+
+        for (j = j1; j < j2; j = k) {
+            /* pixels with the same index */
+            for (k = j + 1; k < j2 && row[k] == row[j]; k++);
+
+            if (row[j] != key) {
+                dc_hw_hline(dc, (color_t *)&palette[row[j]], x + j, x + k, y + i);
+            }
+        }
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Draw a line of pixels through hardware DC
+ * @param[in]  *self        Which DC we used
+ * @param[in]  x            Logic x of line
+ * @param[in]  y            Logic y of line
+ * @param[in]  width        Pixels of line
+ * @param[in]  *pixels      Pixels in format of driver
+ * @param[in]  count        Pixels given, repeated if line is longer
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Pixel j of line is pixels[j % count]. Driver is given the
+ *             piece before the first whole period and then the rest, or
+ *             pixels are drawn one by one if driver can not copy or DC is
+ *             blended.
+ *******************************************************************************
+ */
+static void dc_hw_draw_pixels(dc_t *self, int32_t x, int32_t y, int32_t width,
+                              const void *pixels, int32_t count)
+{
+    struct dc_hw_t *dc;
+    const uint8_t *src;
+    int32_t i, j, j2, k, n, bpp;
+    color_t color;
+    rect_t bound;
+
+    ASSERT(pixels);
+    ASSERT(self != Co_NULL);
+    dc = (struct dc_hw_t *) self;
+
+    dc_hw_get_bound(dc, &bound);
+
+    /* move to logic position and cut by bound */
+    x = x + dc->owner->extent.x1;
+    y = y + dc->owner->extent.y1;
+    if (y < bound.y1 || y >= bound.y2 || count <= 0)
+        return;
+
+    j   = MAX(bound.x1 - x, 0);
+    j2  = MIN(bound.x2 - x, width);
+    bpp = GUI_FB_BPP(dc->hw_driver);
+
+    for (; j < j2; j += n) {
+        k   = j % count;
+        n   = (k != 0) ? MIN(count - k, j2 - j) : j2 - j;
+        src = (const uint8_t *)pixels + k * bpp;
+
+        if (dc->hw_driver->ops->blit_line != Co_NULL && !DC_HW_IS_BLENDED(dc)) {
+            dc->hw_driver->ops->blit_line(src, count - k, x + j, x + j + n, y);
+            continue;
+        }
+
+        for (i = 0; i < n; i++) {
+            src   = (const uint8_t *)pixels + ((k + i) % count) * bpp;
+            color = (bpp == 4) ? gui_color_from_argb8888(*(const uint32_t *)src) : *(const uint16_t *)src;
+            dc_hw_hline(dc, &color, x + j + i, x + j + i + 1, y);
+        }
     }
 }
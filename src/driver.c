@@ -21,3 +21,100 @@ void gui_set_graphic_driver(graphic_driver_t *driver)
 {
 	_current_driver = driver;
 }
+
+/**
+ *******************************************************************************
+ * @brief      Draw into a back buffer and flip it to panel
+ * @param[in]  *driver      Driver to set
+ * @param[in]  back_buffer  Address of second framebuffer, same size as first
+ * @param[out] None
+ * @retval     GUI_E_OK     Double buffering is enabled
+ * @retval     GUI_E_ERROR  Panel can not flip, or pixel format is not supported
+ *
+ * @par Description
+ * @details    After this call all drawing goes to back buffer with generic
+ *             framebuffer operations, and every frame is shown by flipping.
+ *******************************************************************************
+ */
+StatusType gui_graphic_driver_set_double_buffer(graphic_driver_t *driver, uint32_t back_buffer)
+{
+    rect_t rect;
+
+    ASSERT(driver != Co_NULL);
+
+    if (driver->panel_ops == Co_NULL || driver->panel_ops->set_frame_buffer == Co_NULL) {
+        return GUI_E_ERROR;
+    }
+
+    if (gui_framebuffer_get_ops(driver->pixel_format) == Co_NULL || back_buffer == 0) {
+        return GUI_E_ERROR;
+    }
+
+    /* both buffers start with what is on panel */
+    GUI_SET_RECT(&rect, 0, 0, driver->width, driver->height);
+    gui_framebuffer_copy_rect(driver, back_buffer, driver->frame_buffer, &rect);
+
+    driver->front_buffer = driver->frame_buffer;
+    driver->frame_buffer = back_buffer;
+    driver->ops = gui_framebuffer_get_ops(driver->pixel_format);
+    GUI_INIT_RECT(&driver->back_dirty);
+
+    return GUI_E_OK;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Make back buffer up to date before drawing a frame
+ * @param[in]  *driver      Driver to draw
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Only the area changed in last frame is copied back from front
+ *             buffer, instead of the whole screen. Cursor overlay is taken
+ *             away, so widgets are painted on the real screen content.
+ *******************************************************************************
+ */
+void gui_graphic_driver_begin_frame(graphic_driver_t *driver)
+{
+    ASSERT(driver != Co_NULL);
+
+    if (driver->front_buffer != 0) {
+        gui_framebuffer_copy_rect(driver, driver->frame_buffer, driver->front_buffer, &driver->back_dirty);
+        GUI_INIT_RECT(&driver->back_dirty);
+    }
+
+    gui_mouse_overlay_remove();
+}
+
+/**
+ *******************************************************************************
+ * @brief      Show a finished frame
+ * @param[in]  *driver      Driver to draw
+ * @param[in]  *damage      Area drawn in this frame
+ * @param[out] None
+ * @retval     None
+ *******************************************************************************
+ */
+void gui_graphic_driver_end_frame(graphic_driver_t *driver, rect_t *damage)
+{
+    uint32_t buffer;
+
+    ASSERT(driver != Co_NULL);
+    ASSERT(damage != Co_NULL);
+
+    /* cursor is put on top of finished frame */
+    gui_mouse_overlay_draw(damage);
+
+    if (driver->front_buffer == 0 || GUI_RECT_IS_EMPTY(damage)) {
+        return;
+    }
+
+    driver->panel_ops->set_frame_buffer(driver->frame_buffer);
+
+    /* old front buffer misses what is drawn in this frame */
+    buffer = driver->front_buffer;
+    driver->front_buffer = driver->frame_buffer;
+    driver->frame_buffer = buffer;
+    driver->back_dirty = *damage;
+}
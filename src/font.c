@@ -11,6 +11,196 @@
 
 font_t *default_font = &tm_font_7x10;
 
+/**
+ * @struct   glyph_cache font.c
+ * @brief    Unpacked glyph struct
+ * @details  Anti-aliased glyph is kept as coverage a byte, it does not
+ *           depend on colors, so it is used again with any of them.
+ */
+struct glyph_cache {
+    font_t *                 font;       /**< Font of glyph, Co_NULL if free */
+    uint16_t                 index;      /**< Glyph index in font            */
+    uint8_t                  pixels[16 * GUI_FONT_MAX_HEIGHT];
+};
+
+static struct glyph_cache glyph_cache[COGUI_GLYPH_CACHE_SIZE];
+
+/**
+ * @struct   glyph_lut font.c
+ * @brief    Coverage to color table struct
+ * @details  Colors between foreground and background are computed once for
+ *           every pair of colors, not for every pixel.
+ */
+static struct {
+    color_t                  fg;
+    color_t                  bg;
+    uint8_t                  bpp;        /**< 0 if table is not computed     */
+    color_t                  color[16];
+} glyph_lut;
+
+/**
+ *******************************************************************************
+ * @brief      Fill part of text rectangle with background.
+ * @param[in]  *dc      Using this DC engine.
+ * @param[in]  *rect    Text rectangle, area out of it is not filled.
+ * @param[in]  x1       Logical x1 of area.
+ * @param[in]  x2       Logical x2 of area.
+ * @param[in]  y1       Logical y1 of area.
+ * @param[in]  y2       Logical y2 of area.
+ * @param[out] None
+ * @retval     None
+ *******************************************************************************
+ */
+static void _gui_lcd_fill(dc_t *dc, rect_t *rect, int32_t x1, int32_t x2, int32_t y1, int32_t y2)
+{
+    rect_t area;
+
+    area.x1 = MAX(x1, rect->x1);
+    area.x2 = MIN(x2, rect->x2);
+    area.y1 = MAX(y1, rect->y1);
+    area.y2 = MIN(y2, rect->y2);
+
+    if (!GUI_RECT_IS_EMPTY(&area)) {
+        dc->engine->fill_rect(dc, &area);
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Get next character of text.
+ * @param[in]  *font    Which font text uses.
+ * @param[in]  **str    Text position, moved to next character.
+ * @param[out] **str    Position after character.
+ * @retval     c        Character or codepoint, 0 at end of text.
+ *
+ * @par Description
+ * @details    Packed font takes utf-8 text, other fonts are tables of ascii
+ *             and take one byte a character.
+ *******************************************************************************
+ */
+static uint32_t _gui_font_next(font_t *font, const char **str)
+{
+    if (font->packed != Co_NULL) {
+        return gui_utf8_next(str);
+    }
+
+    return **str ? (uint8_t)*(*str)++ : 0;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Unpack glyph bitmap to rows.
+ * @param[in]  *font    Packed font.
+ * @param[in]  *glyph   Which glyph to unpack.
+ * @param[out] *rows    One word a row, left pixel on the highest bit.
+ * @retval     None
+ *******************************************************************************
+ */
+static void _gui_font_unpack(font_t *font, const struct font_packed_glyph *glyph, uint16_t *rows)
+{
+    const uint8_t *bits = &font->packed->bitmap[glyph->offset];
+    uint32_t width = glyph->width;
+    uint32_t pos, word;
+    int32_t  i, x, n, run;
+
+    if (!(glyph->flag & GUI_GLYPH_RLE)) {
+        /* a row takes at most three bytes at any bit position */
+        for (i = 0, pos = 0; i < font->height; i++, pos += width) {
+            word = (uint32_t)bits[pos >> 3] << 16;
+            if ((pos & 7) + width > 8) {
+                word |= (uint32_t)bits[(pos >> 3) + 1] << 8;
+            }
+            if ((pos & 7) + width > 16) {
+                word |= bits[(pos >> 3) + 2];
+            }
+
+            rows[i] = (uint16_t)((word << (pos & 7)) >> 8) & (uint16_t)(0xFFFF << (16 - width));
+        }
+        return;
+    }
+
+    gui_memset(rows, 0, font->height * sizeof(uint16_t));
+
+    /* runs go on across rows */
+    for (i = 0, x = 0; i < font->height && width; bits++) {
+        for (run = (*bits & 0x7F) + 1; run && i < font->height; run -= n) {
+            n = MIN(run, (int32_t)width - x);
+
+            if (*bits & 0x80) {
+                rows[i] |= (uint16_t)(0xFFFF << (16 - n)) >> x;
+            }
+
+            x += n;
+            if (x == (int32_t)width) {
+                x = 0;
+                i++;
+            }
+        }
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Get coverage of anti-aliased glyph.
+ * @param[in]  *font    Anti-aliased packed font.
+ * @param[in]  index    Which glyph to unpack.
+ * @param[out] None
+ * @retval     *pixels  One byte a pixel, row by row.
+ *******************************************************************************
+ */
+static const uint8_t *_gui_font_unpack_aa(font_t *font, uint16_t index)
+{
+    const struct font_packed_glyph *glyph = &font->packed->glyphs[index];
+    struct glyph_cache *cache = &glyph_cache[index % COGUI_GLYPH_CACHE_SIZE];
+    const uint8_t *bits = &font->packed->bitmap[glyph->offset];
+    uint32_t bpp  = font->packed->bpp;
+    uint32_t mask = (1 << bpp) - 1;
+    uint32_t i, n, pos;
+
+    if (cache->font == font && cache->index == index) {
+        return cache->pixels;
+    }
+
+    n = glyph->width * font->height;
+    for (i = 0, pos = 0; i < n; i++, pos += bpp) {
+        cache->pixels[i] = (bits[pos >> 3] >> (8 - bpp - (pos & 7))) & mask;
+    }
+
+    cache->font  = font;
+    cache->index = index;
+
+    return cache->pixels;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Get colors of every coverage.
+ * @param[in]  fg       Text color.
+ * @param[in]  bg       Background color.
+ * @param[in]  bpp      Bits of coverage.
+ * @param[out] None
+ * @retval     *color   Color table, 1 << bpp entries.
+ *******************************************************************************
+ */
+static const color_t *_gui_font_get_lut(color_t fg, color_t bg, uint8_t bpp)
+{
+    uint32_t i, levels = (1 << bpp) - 1;
+
+    if (glyph_lut.bpp == bpp && glyph_lut.fg == fg && glyph_lut.bg == bg) {
+        return glyph_lut.color;
+    }
+
+    for (i = 0; i <= levels; i++) {
+        glyph_lut.color[i] = gui_color_blend(fg, bg, (uint8_t)(i * 255 / levels));
+    }
+
+    glyph_lut.fg  = fg;
+    glyph_lut.bg  = bg;
+    glyph_lut.bpp = bpp;
+
+    return glyph_lut.color;
+}
+
 /**
  *******************************************************************************
  * @brief      Display string to screen.
@@ -22,28 +212,70 @@ font_t *default_font = &tm_font_7x10;
  * @param[in]  *rect    Where to draw the string.
  * @param[out] None
  * @retval     None 
+ *
+ * @par Description
+ * @details    With GUI_TEXT_OPAQUE style, glyph cells are drawn with their
+ *             background and the rest of rect is filled around the lines,
+ *             so every pixel of rect is written once.
  *******************************************************************************
  */
 void gui_lcd_puts(uint16_t x, uint16_t y, char *str, font_t *font, dc_t *dc, rect_t *rect)
 {
-    while (*str) {
-        if (*str == '\n') {
+    bool_t   opaque = (GUI_DC_TA(dc) & GUI_TEXT_OPAQUE) != 0;
+    uint16_t start  = x;
+    uint16_t next;
+    rect_t   cell   = *rect;
+    uint32_t c, c_next;
+    const char *p   = str;
+
+    /* space over first line */
+    if (opaque) {
+        _gui_lcd_fill(dc, rect, rect->x1, rect->x2, rect->y1, y);
+    }
+
+    c = _gui_font_next(font, &p);
+
+    while (c) {
+        if (c == '\n') {
+            if (opaque) {
+                _gui_lcd_fill(dc, rect, rect->x1, start, y, y + font->height);
+                _gui_lcd_fill(dc, rect, x, rect->x2, y, y + font->height);
+            }
+
 			y += font->height;
-            x = rect->x1;
+            x = start = rect->x1;
 			
-			str++;
+			c = _gui_font_next(font, &p);
 			continue;
 		}
 
-        gui_lcd_putc(x, y, *str++, font, dc, rect);
+        /* next glyph moves closer or further with kerning */
+        c_next = _gui_font_next(font, &p);
+        next   = x + gui_font_get_advance(font, c) + gui_font_get_kerning(font, c, c_next);
 
-        x += font->width;
+        /* space after glyph is not filled under next one */
+        cell.x2 = MIN(MAX(next, x), rect->x2);
+        gui_lcd_putc(x, y, c, font, dc, &cell);
+        x = next;
+        c = c_next;
+
+        if (x + gui_font_get_advance(font, c) > rect->x2) {
+            if (opaque) {
+                _gui_lcd_fill(dc, rect, rect->x1, start, y, y + font->height);
+                _gui_lcd_fill(dc, rect, x, rect->x2, y, y + font->height);
+            }
 
-        if (x + font->width > rect->x2) {
             y += font->height;
-            x = rect->x1;
+            x = start = rect->x1;
 	    }
     }
+
+    /* rest of last line and space under it */
+    if (opaque) {
+        _gui_lcd_fill(dc, rect, rect->x1, start, y, y + font->height);
+        _gui_lcd_fill(dc, rect, x, rect->x2, y, y + font->height);
+        _gui_lcd_fill(dc, rect, rect->x1, rect->x2, y + font->height, rect->y2);
+    }
 }
 
 /**
@@ -51,7 +283,7 @@ void gui_lcd_puts(uint16_t x, uint16_t y, char *str, font_t *font, dc_t *dc, rec
  * @brief      Display a character to screen.
  * @param[in]  x        Logical x to rect.
  * @param[in]  y        Logical y to rect.
- * @param[in]  c        Character to display.
+ * @param[in]  c        Character or codepoint to display.
  * @param[in]  *font    Which font to use.
  * @param[in]  *dc      Using this DC engine.
  * @param[in]  *rect    Where to draw the string.
@@ -59,18 +291,186 @@ void gui_lcd_puts(uint16_t x, uint16_t y, char *str, font_t *font, dc_t *dc, rec
  * @retval     None 
  *******************************************************************************
  */
-void gui_lcd_putc(uint16_t x, uint16_t y, char c, font_t *font, dc_t *dc, rect_t *rect)
+void gui_lcd_putc(uint16_t x, uint16_t y, uint32_t c, font_t *font, dc_t *dc, rect_t *rect)
 {	
-	uint16_t i, j, f;
-	for ( i=0; i<font->height; i++) {
-		/* first element in font table is "space", which is 32 in ASCII */
-		f = font->data[(c - 32)*font->height + i];
-		for ( j=0; j<font->width; j++) {
-			if ((f << j) & 0x8000) {
-				dc->engine->draw_point(dc, x+j, y+i);
-			}
-		}
-	}
+    bool_t opaque = (GUI_DC_TA(dc) & GUI_TEXT_OPAQUE) != 0;
+    const struct font_glyph *glyph;
+    const struct font_packed_glyph *packed;
+    uint16_t rows[GUI_FONT_MAX_HEIGHT];
+    uint16_t index;
+
+    if (font->packed != Co_NULL) {
+        index = gui_font_find_glyph(font, c);
+        if (index == GUI_GLYPH_NONE) {
+            return;
+        }
+
+        ASSERT(font->height <= GUI_FONT_MAX_HEIGHT);
+        packed = &font->packed->glyphs[index];
+
+        /* coverage is blended onto background color, not onto screen */
+        if (font->packed->bpp > 1) {
+            dc->engine->draw_indexed(dc, x, y, packed->width, font->height,
+                                     _gui_font_unpack_aa(font, index),
+                                     _gui_font_get_lut(GUI_DC_FC(dc), GUI_DC_BC(dc),
+                                                       font->packed->bpp),
+                                     opaque ? -1 : 0);
+        }
+        else {
+            _gui_font_unpack(font, packed, rows);
+            dc->engine->draw_glyph(dc, x, y, 0, packed->width, font->height, rows, opaque);
+        }
+
+        if (opaque && packed->advance > packed->width) {
+            _gui_lcd_fill(dc, rect, x + packed->width, x + packed->advance, y, y + font->height);
+        }
+        return;
+    }
+
+    /* only characters in font table */
+    if (c < ' ' || c > '~') {
+        return;
+    }
+
+	/* first element in font table is "space", which is 32 in ASCII */
+    if (GUI_FONT_IS_MONO(font)) {
+	    dc->engine->draw_glyph(dc, x, y, 0, font->width, font->height, &font->data[(c - 32)*font->height], opaque);
+        return;
+    }
+
+    /* only columns with ink are drawn, space to next glyph is filled */
+    glyph = &font->glyphs[c - 32];
+    dc->engine->draw_glyph(dc, x, y, glyph->left, glyph->width, font->height, &font->data[(c - 32)*font->height], opaque);
+
+    if (opaque && glyph->advance > glyph->width) {
+        _gui_lcd_fill(dc, rect, x + glyph->width, x + glyph->advance, y, y + font->height);
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Find glyph of a codepoint in packed font.
+ * @param[in]  *font            Packed font.
+ * @param[in]  c                Codepoint to find.
+ * @param[out] None
+ * @retval     index            Glyph index, missing glyph if not found.
+ * @retval     GUI_GLYPH_NONE   Control character or nothing to draw.
+ *
+ * @par Description
+ * @details    Ranges are sorted, so it is a binary search over ranges
+ *             instead of glyphs.
+ *******************************************************************************
+ */
+uint16_t gui_font_find_glyph(font_t *font, uint32_t c)
+{
+    const struct font_range *range;
+    int32_t lo, hi, mid;
+
+    ASSERT(font != Co_NULL && font->packed != Co_NULL);
+
+    if (c < ' ') {
+        return GUI_GLYPH_NONE;
+    }
+
+    lo = 0;
+    hi = (int32_t)font->packed->range_cnt - 1;
+
+    while (lo <= hi) {
+        mid   = (lo + hi) >> 1;
+        range = &font->packed->ranges[mid];
+
+        if (c < range->first) {
+            hi = mid - 1;
+        }
+        else if (c >= range->first + range->count) {
+            lo = mid + 1;
+        }
+        else {
+            return range->glyph + (uint16_t)(c - range->first);
+        }
+    }
+
+    return font->packed->missing;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Get how far pen moves after a character.
+ * @param[in]  *font            Choosing which font.
+ * @param[in]  c                Character or codepoint to draw.
+ * @param[out] None
+ * @retval     advance          Pen movement, 0 for character out of table.
+ *
+ * @par Description
+ * @details    Monospace font moves width for every character.
+ *******************************************************************************
+ */
+uint16_t gui_font_get_advance(font_t *font, uint32_t c)
+{
+    uint16_t index;
+
+    ASSERT(font != Co_NULL);
+
+    if (GUI_FONT_IS_MONO(font)) {
+        return font->width;
+    }
+
+    if (font->packed != Co_NULL) {
+        index = gui_font_find_glyph(font, c);
+        return index != GUI_GLYPH_NONE ? font->packed->glyphs[index].advance : 0;
+    }
+
+    if (c < ' ' || c > '~') {
+        return 0;
+    }
+
+    return font->glyphs[c - 32].advance;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Get kerning between two characters.
+ * @param[in]  *font            Choosing which font.
+ * @param[in]  left             Character on the left.
+ * @param[in]  right            Character on the right.
+ * @param[out] None
+ * @retval     adjust           Pen movement added between them.
+ *
+ * @par Description
+ * @details    Kerning pairs are sorted, so it is a binary search. Only
+ *             characters below 256 have pairs.
+ *******************************************************************************
+ */
+int16_t gui_font_get_kerning(font_t *font, uint32_t left, uint32_t right)
+{
+    uint16_t pair = GUI_FONT_KERN_PAIR(left, right);
+    int32_t  lo, hi, mid;
+
+    ASSERT(font != Co_NULL);
+
+    if (left > 0xFF || right > 0xFF) {
+        return 0;
+    }
+
+    lo = 0;
+    hi = (int32_t)font->kern_cnt - 1;
+
+    while (lo <= hi) {
+        mid = (lo + hi) >> 1;
+
+        if (font->kerning[mid].pair == pair) {
+            return font->kerning[mid].adjust;
+        }
+
+        if (font->kerning[mid].pair < pair) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid - 1;
+        }
+    }
+
+    return 0;
 }
 
 /**
@@ -88,9 +488,22 @@ uint32_t gui_get_text_width(char *str, font_t *font)
 
     uint32_t text_width;
     uint64_t str_len = str != Co_NULL ? gui_strlen(str) : 0;
+    uint32_t c, c_next;
+    const char *p = str;
 
     /* compute text widget */
-    text_width = str_len * font->width;
+    if (GUI_FONT_IS_MONO(font)) {
+        text_width = str_len * font->width;
+        return text_width;
+    }
+
+    text_width = 0;
+    c = str_len ? _gui_font_next(font, &p) : 0;
+
+    for (; c; c = c_next) {
+        c_next = _gui_font_next(font, &p);
+        text_width += gui_font_get_advance(font, c) + gui_font_get_kerning(font, c, c_next);
+    }
 
     return text_width;
 }
@@ -103,6 +516,10 @@ uint32_t gui_get_text_width(char *str, font_t *font)
  * @param[in]  *rect            Where are the string.
  * @param[out] None
  * @retval     text_height      Result of string height.
+ *
+ * @par Description
+ * @details    Lines are broken on '\n' and where next glyph does not fit,
+ *             with the same advance, kerning and rule as gui_lcd_puts.
  *******************************************************************************
  */
 uint32_t gui_get_text_height(char *str, font_t *font, rect_t *rect)
@@ -110,17 +527,87 @@ uint32_t gui_get_text_height(char *str, font_t *font, rect_t *rect)
     ASSERT(rect != Co_NULL);
     ASSERT(font != Co_NULL);
 
-    uint32_t rect_width = GUI_RECT_WIDTH(rect);
-    uint32_t text_width;
-    uint32_t text_height;
-    uint32_t lines;
+    int32_t  rect_width = GUI_RECT_WIDTH(rect);
+    int32_t  x = 0;
+    uint32_t lines = 1;
+    uint32_t c, c_next;
+    const char *p = str;
 
-    /* how many lines does this text has in this rectangle */
-    text_width = gui_get_text_width(str, font);
-    lines = text_width / rect_width + 1;
+    c = (str != Co_NULL) ? _gui_font_next(font, &p) : 0;
+
+    while (c) {
+        if (c == '\n') {
+            lines++;
+            x = 0;
+            c = _gui_font_next(font, &p);
+            continue;
+        }
+
+        c_next = _gui_font_next(font, &p);
+        x += gui_font_get_advance(font, c) + gui_font_get_kerning(font, c, c_next);
+        c  = c_next;
+
+        /* wrap after last glyph leaves no text on the new line */
+        if (c && x + gui_font_get_advance(font, c) > rect_width) {
+            lines++;
+            x = 0;
+        }
+    }
 
     /* compute text height */
-    text_height = lines * font->height;
+    return lines * font->height;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Decode next codepoint of utf-8 text.
+ * @param[in]  **str            Text position.
+ * @param[out] **str            Position after codepoint, kept at end of text.
+ * @retval     c                Codepoint, 0 at end of text.
+ * @retval     GUI_UTF8_INVALID Bad sequence, skipped up to next lead byte.
+ *******************************************************************************
+ */
+uint32_t gui_utf8_next(const char **str)
+{
+    const uint8_t *s = (const uint8_t *)*str;
+    uint32_t c;
+    int32_t  i, n;
+
+    ASSERT(str != Co_NULL && *str != Co_NULL);
+
+    if (s[0] < 0x80) {
+        if (s[0]) {
+            (*str)++;
+        }
+        return s[0];
+    }
+
+    /* lead byte tells length of sequence */
+    if ((s[0] & 0xE0) == 0xC0) {
+        c = s[0] & 0x1F;
+        n = 1;
+    }
+    else if ((s[0] & 0xF0) == 0xE0) {
+        c = s[0] & 0x0F;
+        n = 2;
+    }
+    else if ((s[0] & 0xF8) == 0xF0) {
+        c = s[0] & 0x07;
+        n = 3;
+    }
+    else {
+        (*str)++;
+        return GUI_UTF8_INVALID;
+    }
+
+    for (i = 1; i <= n; i++) {
+        if ((s[i] & 0xC0) != 0x80) {
+            *str += i;
+            return GUI_UTF8_INVALID;
+        }
+        c = (c << 6) | (s[i] & 0x3F);
+    }
 
-    return text_height;
+    *str += n + 1;
+    return c;
 }
@@ -0,0 +1,399 @@
+/**
+ *******************************************************************************
+ * @file       framebuffer.c
+ * @version    V0.7.4
+ * @date       2020.04.18
+ * @brief      Generic framebuffer driver operations for GUI engine.
+ *******************************************************************************
+ */
+
+#include <cogui.h>
+
+/* address of pixel (x, y) in current drawing buffer */
+#define GUI_FB_PIXEL(d, x, y)     ((uint16_t *)((d)->frame_buffer + (y)*GUI_FB_PITCH(d)) + (x))
+#define GUI_FB_PIXEL32(d, x, y)   ((uint32_t *)((d)->frame_buffer + (y)*GUI_FB_PITCH(d)) + (x))
+
+/* address of pixel (x, y) of any pixel size, as 16 bits words */
+#define GUI_FB_WORDS(d, x, y)     ((uint16_t *)((d)->frame_buffer + (y)*GUI_FB_PITCH(d) + (x)*GUI_FB_BPP(d)))
+
+/* rgb565 with green moved to high half word, channels do not touch */
+#define GUI_RGB565_SPREAD(p)      (((p) | ((p) << 16)) & 0x07E0F81F)
+
+static void _gui_framebuffer_copy_line(uint16_t *d, const uint16_t *s, int16_t n);
+
+static void framebuffer_rgb565_set_pixel(color_t *c, int32_t x, int32_t y)
+{
+    graphic_driver_t *driver = gui_graphic_driver_get_default();
+
+    *GUI_FB_PIXEL(driver, x, y) = (uint16_t)*c;
+}
+
+static void framebuffer_rgb565_get_pixel(color_t *c, int32_t x, int32_t y)
+{
+    graphic_driver_t *driver = gui_graphic_driver_get_default();
+
+    *c = *GUI_FB_PIXEL(driver, x, y);
+}
+
+static void framebuffer_rgb565_draw_hline(color_t *c, int32_t x1, int32_t x2, int32_t y)
+{
+    graphic_driver_t *driver = gui_graphic_driver_get_default();
+    uint16_t *dst = GUI_FB_PIXEL(driver, x1, y);
+    uint16_t pixel = (uint16_t)*c;
+
+    for (; x1 < x2; x1++) {
+        *dst++ = pixel;
+    }
+}
+
+static void framebuffer_rgb565_draw_vline(color_t *c, int32_t x, int32_t y1, int32_t y2)
+{
+    graphic_driver_t *driver = gui_graphic_driver_get_default();
+    uint8_t *dst = (uint8_t *)GUI_FB_PIXEL(driver, x, y1);
+    uint16_t pixel = (uint16_t)*c;
+
+    for (; y1 < y2; y1++) {
+        *(uint16_t *)dst = pixel;
+        dst += GUI_FB_PITCH(driver);
+    }
+}
+
+static void framebuffer_copy_area(rect_t *rect, int32_t dx, int32_t dy)
+{
+    gui_framebuffer_move_rect(gui_graphic_driver_get_default(), rect, dx, dy);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Blend a color onto a line of rgb565 framebuffer
+ * @param[in]  *c       Color to blend
+ * @param[in]  alpha    Weight of color, 0 to 255
+ * @param[in]  x1       First pixel
+ * @param[in]  x2       Pixel after the last one
+ * @param[in]  y        Line
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Three channels of a pixel are spread in one word with room to
+ *             multiply by 5 bits alpha, so a pixel takes one multiply and
+ *             the color part is worked out once a line.
+ *******************************************************************************
+ */
+static void framebuffer_rgb565_blend_hline(color_t *c, uint8_t alpha, int32_t x1, int32_t x2, int32_t y)
+{
+    graphic_driver_t *driver = gui_graphic_driver_get_default();
+    uint16_t *dst = GUI_FB_PIXEL(driver, x1, y);
+    uint32_t a = (alpha + 4) >> 3;
+    uint32_t na = 32 - a;
+    uint32_t fg, bg;
+
+    /* color part with half of last bit for rounding */
+    fg = GUI_RGB565_SPREAD((uint32_t)(uint16_t)*c) * a + 0x02008010;
+
+    for (; x1 < x2; x1++) {
+        bg = *dst;
+        bg = ((fg + GUI_RGB565_SPREAD(bg) * na) >> 5) & 0x07E0F81F;
+        *dst++ = (uint16_t)(bg | (bg >> 16));
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Copy a repeated line of pixels into rgb565 framebuffer
+ * @param[in]  *pixels  Pixels to copy
+ * @param[in]  count    Pixels given, repeated if line is longer
+ * @param[in]  x1       First pixel
+ * @param[in]  x2       Pixel after the last one
+ * @param[in]  y        Line
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Pixels are copied once, then what is written is copied after
+ *             itself with twice the length each time.
+ *******************************************************************************
+ */
+static void framebuffer_rgb565_blit_line(const void *pixels, int32_t count, int32_t x1, int32_t x2, int32_t y)
+{
+    graphic_driver_t *driver = gui_graphic_driver_get_default();
+    uint16_t *dst = GUI_FB_PIXEL(driver, x1, y);
+    int32_t  n = MIN(count, x2 - x1);
+
+    _gui_framebuffer_copy_line(dst, pixels, n);
+    for (; n < x2 - x1; n *= 2) {
+        _gui_framebuffer_copy_line(dst + n, dst, MIN(n, x2 - x1 - n));
+    }
+}
+
+/* operations drawing into driver->frame_buffer, used by double buffering */
+const struct graphic_driver_ops gui_framebuffer_rgb565_ops =
+{
+    framebuffer_rgb565_set_pixel,
+    framebuffer_rgb565_get_pixel,
+    framebuffer_rgb565_draw_hline,
+    framebuffer_rgb565_draw_vline,
+    framebuffer_copy_area,
+    framebuffer_rgb565_blend_hline,
+    framebuffer_rgb565_blit_line,
+};
+
+static void framebuffer_argb8888_set_pixel(color_t *c, int32_t x, int32_t y)
+{
+    graphic_driver_t *driver = gui_graphic_driver_get_default();
+
+    *GUI_FB_PIXEL32(driver, x, y) = gui_color_to_argb8888(*c);
+}
+
+static void framebuffer_argb8888_get_pixel(color_t *c, int32_t x, int32_t y)
+{
+    graphic_driver_t *driver = gui_graphic_driver_get_default();
+
+    *c = gui_color_from_argb8888(*GUI_FB_PIXEL32(driver, x, y));
+}
+
+static void framebuffer_argb8888_draw_hline(color_t *c, int32_t x1, int32_t x2, int32_t y)
+{
+    graphic_driver_t *driver = gui_graphic_driver_get_default();
+    uint32_t *dst = GUI_FB_PIXEL32(driver, x1, y);
+    uint32_t pixel = gui_color_to_argb8888(*c);
+
+    for (; x1 < x2; x1++) {
+        *dst++ = pixel;
+    }
+}
+
+static void framebuffer_argb8888_draw_vline(color_t *c, int32_t x, int32_t y1, int32_t y2)
+{
+    graphic_driver_t *driver = gui_graphic_driver_get_default();
+    uint8_t *dst = (uint8_t *)GUI_FB_PIXEL32(driver, x, y1);
+    uint32_t pixel = gui_color_to_argb8888(*c);
+
+    for (; y1 < y2; y1++) {
+        *(uint32_t *)dst = pixel;
+        dst += GUI_FB_PITCH(driver);
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Blend a color onto a line of argb8888 framebuffer
+ * @param[in]  *c       Color to blend
+ * @param[in]  alpha    Weight of color, 0 to 255
+ * @param[in]  x1       First pixel
+ * @param[in]  x2       Pixel after the last one
+ * @param[in]  y        Line
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Red with blue and alpha with green are blended as two pairs
+ *             of 16 bits lanes, two multiplies a pixel. Alpha of pixel goes
+ *             up like painting over it.
+ *******************************************************************************
+ */
+static void framebuffer_argb8888_blend_hline(color_t *c, uint8_t alpha, int32_t x1, int32_t x2, int32_t y)
+{
+    graphic_driver_t *driver = gui_graphic_driver_get_default();
+    uint32_t *dst = GUI_FB_PIXEL32(driver, x1, y);
+    uint32_t pixel = gui_color_to_argb8888(*c) | 0xFF000000;
+    uint32_t a = alpha + (alpha >> 7);
+    uint32_t na = 256 - a;
+    uint32_t rb, ag, bg;
+
+    /* color part with half of last bit for rounding */
+    rb = (pixel & 0x00FF00FF) * a + 0x00800080;
+    ag = ((pixel >> 8) & 0x00FF00FF) * a + 0x00800080;
+
+    for (; x1 < x2; x1++) {
+        bg = *dst;
+        *dst++ = (((rb + (bg & 0x00FF00FF) * na) >> 8) & 0x00FF00FF) |
+                 ((ag + ((bg >> 8) & 0x00FF00FF) * na) & 0xFF00FF00);
+    }
+}
+
+static void framebuffer_argb8888_blit_line(const void *pixels, int32_t count, int32_t x1, int32_t x2, int32_t y)
+{
+    graphic_driver_t *driver = gui_graphic_driver_get_default();
+    uint32_t *dst = GUI_FB_PIXEL32(driver, x1, y);
+    int32_t  n = MIN(count, x2 - x1);
+
+    _gui_framebuffer_copy_line((uint16_t *)dst, pixels, n * 2);
+    for (; n < x2 - x1; n *= 2) {
+        _gui_framebuffer_copy_line((uint16_t *)(dst + n), (uint16_t *)dst, MIN(n, x2 - x1 - n) * 2);
+    }
+}
+
+/* operations drawing into an argb8888 driver->frame_buffer */
+const struct graphic_driver_ops gui_framebuffer_argb8888_ops =
+{
+    framebuffer_argb8888_set_pixel,
+    framebuffer_argb8888_get_pixel,
+    framebuffer_argb8888_draw_hline,
+    framebuffer_argb8888_draw_vline,
+    framebuffer_copy_area,
+    framebuffer_argb8888_blend_hline,
+    framebuffer_argb8888_blit_line,
+};
+
+/**
+ *******************************************************************************
+ * @brief      Get generic framebuffer operations of a pixel format
+ * @param[in]  pixel_format     Pixel format of framebuffer
+ * @param[out] None
+ * @retval     *ops             Operations drawing into driver->frame_buffer
+ * @retval     Co_NULL          Pixel format is not supported
+ *******************************************************************************
+ */
+const struct graphic_driver_ops *gui_framebuffer_get_ops(uint8_t pixel_format)
+{
+    switch (pixel_format) {
+        case GRAPHIC_PIXEL_FORMAT_RGB565:
+            return &gui_framebuffer_rgb565_ops;
+
+        case GRAPHIC_PIXEL_FORMAT_ARGB888:
+            return &gui_framebuffer_argb8888_ops;
+
+        default:
+            return Co_NULL;
+    }
+}
+
+/* copy a line of half words, two at a time once address is word aligned */
+static void _gui_framebuffer_copy_line(uint16_t *d, const uint16_t *s, int16_t n)
+{
+    /* addresses can not be aligned together, copy one half word a time */
+    if (((uint32_t)d ^ (uint32_t)s) & 0x02) {
+        while (n-- > 0) {
+            *d++ = *s++;
+        }
+        return;
+    }
+
+    if (((uint32_t)d & 0x02) && n > 0) {
+        *d++ = *s++;
+        n--;
+    }
+    for (; n >= 2; n -= 2) {
+        *(uint32_t *)d = *(const uint32_t *)s;
+        d += 2;
+        s += 2;
+    }
+    if (n > 0) {
+        *d = *s;
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Copy a rectangle between two framebuffers
+ * @param[in]  *driver  Driver gives size and pitch of buffers
+ * @param[in]  dst      Address of destination buffer
+ * @param[in]  src      Address of source buffer
+ * @param[in]  *rect    Physical rectangle to copy
+ * @param[out] None
+ * @retval     None
+ *******************************************************************************
+ */
+void gui_framebuffer_copy_rect(graphic_driver_t *driver, uint32_t dst, uint32_t src, rect_t *rect)
+{
+    uint16_t pitch = GUI_FB_PITCH(driver);
+    uint16_t bpp = GUI_FB_BPP(driver);
+    int16_t  y;
+
+    ASSERT(driver != Co_NULL);
+    ASSERT(rect != Co_NULL);
+
+    if (GUI_RECT_IS_EMPTY(rect)) {
+        return;
+    }
+
+    for (y = rect->y1; y < rect->y2; y++) {
+        _gui_framebuffer_copy_line((uint16_t *)(dst + y * pitch + rect->x1 * bpp),
+                                   (uint16_t *)(src + y * pitch + rect->x1 * bpp),
+                                   GUI_RECT_WIDTH(rect) * bpp / 2);
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Copy a rectangle from one driver buffer to another
+ * @param[in]  *dst     Destination driver
+ * @param[in]  *src     Source driver
+ * @param[in]  *rect    Physical rectangle to copy
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Both drivers are addressed with physical coordinates, so a
+ *             window backing store can be copied to screen directly. Both
+ *             should have the same pixel size.
+ *******************************************************************************
+ */
+void gui_framebuffer_blit(graphic_driver_t *dst, graphic_driver_t *src, rect_t *rect)
+{
+    int16_t y;
+
+    ASSERT(dst != Co_NULL && src != Co_NULL);
+    ASSERT(rect != Co_NULL);
+    ASSERT(GUI_FB_BPP(dst) == GUI_FB_BPP(src));
+
+    if (GUI_RECT_IS_EMPTY(rect)) {
+        return;
+    }
+
+    for (y = rect->y1; y < rect->y2; y++) {
+        _gui_framebuffer_copy_line(GUI_FB_WORDS(dst, rect->x1, y), GUI_FB_WORDS(src, rect->x1, y),
+                                   GUI_RECT_WIDTH(rect) * GUI_FB_BPP(src) / 2);
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Move pixels of a rectangle inside framebuffer
+ * @param[in]  *driver  Driver to draw
+ * @param[in]  *rect    Physical source rectangle
+ * @param[in]  dx       Distance to move on x axis
+ * @param[in]  dy       Distance to move on y axis
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Source and destination may overlap, lines are copied in the
+ *             order that does not overwrite pixels not moved yet. Caller
+ *             should make sure destination is inside the buffer.
+ *******************************************************************************
+ */
+void gui_framebuffer_move_rect(graphic_driver_t *driver, rect_t *rect, int32_t dx, int32_t dy)
+{
+    uint16_t *d, *s;
+    int16_t  y, n, i;
+    int16_t  w = GUI_RECT_WIDTH(rect) * GUI_FB_BPP(driver) / 2;
+
+    ASSERT(driver != Co_NULL);
+    ASSERT(rect != Co_NULL);
+
+    if (GUI_RECT_IS_EMPTY(rect) || (dx == 0 && dy == 0)) {
+        return;
+    }
+
+    /* moving down, start from the last line */
+    for (n = 0; n < GUI_RECT_HEIGHT(rect); n++) {
+        y = (dy > 0) ? rect->y2 - 1 - n : rect->y1 + n;
+
+        d = GUI_FB_WORDS(driver, rect->x1 + dx, y + dy);
+        s = GUI_FB_WORDS(driver, rect->x1, y);
+
+        if (dy == 0 && dx > 0) {
+            /* same line moving right, copy from the end */
+            d += w;
+            s += w;
+            for (i = w; i > 0; i--) {
+                *--d = *--s;
+            }
+        }
+        else {
+            _gui_framebuffer_copy_line(d, s, w);
+        }
+    }
+}
@@ -0,0 +1,232 @@
+/**
+ *******************************************************************************
+ * @file       gradient.c
+ * @version    V0.7.4
+ * @date       2020.04.18
+ * @brief      Gradient fill function for GUI engine.
+ *******************************************************************************
+ */
+
+#include <cogui.h>
+
+/* 4x4 ordered (Bayer) dither thresholds, 0 to 15 */
+static const uint8_t gradient_bayer[GUI_DITHER_SIZE][GUI_DITHER_SIZE] =
+{
+    {  0,  8,  2, 10 },
+    { 12,  4, 14,  6 },
+    {  3, 11,  1,  9 },
+    { 15,  7, 13,  5 },
+};
+
+/**
+ *******************************************************************************
+ * @brief      Get color of a place along gradient
+ * @param[in]  *stops   Color stops, sorted by place
+ * @param[in]  count    Number of stops
+ * @param[in]  t        Place, 0 to 65535
+ * @param[out] *rgb     Red, green and blue, 0 to 65535 each
+ * @retval     None
+ *******************************************************************************
+ */
+static void _gui_gradient_color(const struct gradient_stop *stops, int32_t count,
+                                uint32_t t, uint32_t *rgb)
+{
+    uint32_t c0, c1, p0, p1;
+    int32_t  i, k;
+
+    /* stop on or after t, first and last stop cover both ends */
+    for (i = 0; i < count - 1 && stops[i].pos * 257U < t; i++);
+
+    c1 = gui_color_to_argb8888(stops[i].color);
+    if (i == 0 || stops[i].pos * 257U <= t) {
+        for (k = 0; k < 3; k++) {
+            rgb[k] = ((c1 >> (16 - 8 * k)) & 0xFF) * 257;
+        }
+        return;
+    }
+
+    c0 = gui_color_to_argb8888(stops[i - 1].color);
+    p0 = stops[i - 1].pos * 257U;
+    p1 = stops[i].pos * 257U;
+
+    for (k = 0; k < 3; k++) {
+        rgb[k] = ((c0 >> (16 - 8 * k)) & 0xFF) * 257;
+        rgb[k] = rgb[k] + (int32_t)(((c1 >> (16 - 8 * k)) & 0xFF) * 257 - rgb[k]) *
+                          (int64_t)(t - p0) / (int32_t)(p1 - p0);
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Put a gradient color into a pixel of screen format
+ * @param[in]  *rgb     Red, green and blue, 0 to 65535 each
+ * @param[in]  bpp      Bytes a pixel
+ * @param[in]  d        Dither threshold, 0 to 15
+ * @param[out] *pixel   Pixel to write
+ * @retval     None
+ *
+ * @par Description
+ * @details    16 bits pixel is rounded up or down by dither threshold, so
+ *             pixels around keep the color finer than 5 or 6 bits can.
+ *******************************************************************************
+ */
+static void _gui_gradient_pixel(const uint32_t *rgb, uint8_t bpp, uint32_t d, uint8_t *pixel)
+{
+    uint32_t r, g, b;
+
+    if (bpp == 4) {
+        r = (rgb[0] * 255 + 32767) / 65535;
+        g = (rgb[1] * 255 + 32767) / 65535;
+        b = (rgb[2] * 255 + 32767) / 65535;
+        *(uint32_t *)pixel = 0xFF000000 | (r << 16) | (g << 8) | b;
+        return;
+    }
+
+    d = (2 * d + 1) * 65535;
+    r = (rgb[0] * 31 * 32 + d) / (65535 * 32);
+    g = (rgb[1] * 63 * 32 + d) / (65535 * 32);
+    b = (rgb[2] * 31 * 32 + d) / (65535 * 32);
+    *(uint16_t *)pixel = (uint16_t)GUI_RGB(r << 3, g << 2, b << 3);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Create a gradient
+ * @param[in]  direction    GUI_GRADIENT_VERTICAL or GUI_GRADIENT_HORIZONTAL
+ * @param[in]  length       Pixels along gradient, height or width of fill
+ * @param[in]  *stops       Color stops, sorted by place
+ * @param[in]  count        Number of stops, 1 at least
+ * @param[out] None
+ * @retval     *gradient    Gradient created
+ * @retval     Co_NULL      No memory for gradient, or length is not 1 to
+ *                          32767
+ *
+ * @par Description
+ * @details    Every color is worked out once here, in pixel format of screen
+ *             and dithered for 16 bits screen, so a gradient can be kept by
+ *             a widget and filled on every paint without color math.
+ *******************************************************************************
+ */
+gradient_t *gui_gradient_create(uint8_t direction, int32_t length,
+                                const struct gradient_stop *stops, int32_t count)
+{
+    gradient_t *gradient;
+    uint8_t     bpp, *row;
+    int16_t     rows, span;
+    uint32_t    rgb[3];
+    int32_t     i, j;
+
+    ASSERT(stops != Co_NULL && count > 0);
+
+    /* length is kept in 16 bits */
+    if (length <= 0 || length > 0x7FFF) {
+        return Co_NULL;
+    }
+
+    bpp = GUI_FB_BPP(gui_graphic_driver_get_default());
+
+    if (direction == GUI_GRADIENT_VERTICAL) {
+        rows = length;
+        span = (bpp == 2) ? GUI_DITHER_SIZE : 1;
+    }
+    else {
+        rows = (bpp == 2) ? GUI_DITHER_SIZE : 1;
+        span = length;
+    }
+
+    gradient = gui_malloc(sizeof(gradient_t) + (uint32_t)rows * span * bpp);
+    if (gradient == Co_NULL) {
+        return Co_NULL;
+    }
+
+    gradient->direction = direction;
+    gradient->bpp       = bpp;
+    gradient->length    = length;
+    gradient->rows      = rows;
+    gradient->span      = span;
+    gradient->pixels    = (uint8_t *)(gradient + 1);
+
+    /* color of pixel center, once a place */
+    for (i = 0; i < length; i++) {
+        _gui_gradient_color(stops, count, ((uint32_t)(2 * i + 1) << 15) / (uint32_t)length, rgb);
+
+        if (direction == GUI_GRADIENT_VERTICAL) {
+            row = gradient->pixels + i * span * bpp;
+            for (j = 0; j < span; j++) {
+                _gui_gradient_pixel(rgb, bpp, gradient_bayer[i % GUI_DITHER_SIZE][j % GUI_DITHER_SIZE],
+                                    row + j * bpp);
+            }
+        }
+        else {
+            for (j = 0; j < rows; j++) {
+                row = gradient->pixels + j * span * bpp;
+                _gui_gradient_pixel(rgb, bpp, gradient_bayer[j][i % GUI_DITHER_SIZE], row + i * bpp);
+            }
+        }
+    }
+
+    return gradient;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Delete a gradient
+ * @param[in]  *gradient    Gradient to delete
+ * @param[out] None
+ * @retval     None
+ *******************************************************************************
+ */
+void gui_gradient_delete(gradient_t *gradient)
+{
+    if (gradient != Co_NULL) {
+        gui_free(gradient);
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Fill a rectangle with a gradient
+ * @param[in]  *dc          Using this DC to draw
+ * @param[in]  *rect        Rectangle to fill
+ * @param[in]  *gradient    Gradient made by gui_gradient_create
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Gradient starts at top or left of rectangle, the part of
+ *             rectangle longer than gradient is not filled. Each line is
+ *             copied from a kept row, cut by DC bound.
+ *******************************************************************************
+ */
+void gui_dc_fill_gradient(dc_t *dc, rect_t *rect, gradient_t *gradient)
+{
+    int32_t y, y2, w;
+    rect_t  bound;
+    uint8_t *row;
+
+    ASSERT(dc != Co_NULL);
+    ASSERT(gradient != Co_NULL);
+
+    if (rect == Co_NULL || GUI_RECT_IS_EMPTY(rect)) {
+        return;
+    }
+
+    gui_dc_get_bound(dc, &bound);
+
+    w  = GUI_RECT_WIDTH(rect);
+    y2 = rect->y2;
+    if (gradient->direction == GUI_GRADIENT_VERTICAL) {
+        y2 = MIN(y2, rect->y1 + gradient->length);
+    }
+    else {
+        w = MIN(w, gradient->length);
+    }
+
+    y  = MAX(rect->y1, bound.y1);
+    y2 = MIN(y2, bound.y2);
+
+    for (; y < y2; y++) {
+        row = gradient->pixels + ((y - rect->y1) % gradient->rows) * gradient->span * gradient->bpp;
+        dc->engine->draw_pixels(dc, rect->x1, y, w, row, gradient->span);
+    }
+}
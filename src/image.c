@@ -0,0 +1,560 @@
+/**
+ *******************************************************************************
+ * @file       image.c
+ * @version    V0.7.4
+ * @date       2020.04.18
+ * @brief      Image drawing function for GUI engine.
+ *******************************************************************************
+ */
+
+#include <cogui.h>
+
+/**
+ * @struct   image_reader image.c
+ * @brief    Image reader struct
+ * @details  This struct is place of next pixel to read, row and column for
+ *           plain data, or byte and run left for run length coded data.
+ */
+struct image_reader
+{
+    const image_t *   image;        /**< image to read                     */
+    const uint8_t *   src;          /**< next byte of runs                 */
+    int32_t           row, col;     /**< next pixel of plain data          */
+    int32_t           left;         /**< pixels left in current run        */
+    bool_t            repeat;       /**< current run repeats one pixel     */
+};
+
+/* bits a pixel of format */
+static const uint8_t image_bits[] = { 16, 32, 1, 4, 8 };
+
+/* bytes a pixel after reading, index is read as a byte */
+#define GUI_IMAGE_UNIT(i)     (GUI_IMAGE_IS_INDEXED(i) ? 1 : image_bits[(i)->format] / 8)
+
+/* bytes a row of plain data */
+#define GUI_IMAGE_STRIDE(i)   (((uint32_t)(i)->width * image_bits[(i)->format] + 7) >> 3)
+
+/**
+ *******************************************************************************
+ * @brief      Read pixels of image
+ * @param[in]  *reader  Place to read from
+ * @param[in]  n        Pixels to read
+ * @param[out] *out     Pixels read, or Co_NULL to skip them
+ * @retval     None
+ *
+ * @par Description
+ * @details    Plain data is read from one row only, runs are read on across
+ *             rows. A run is skipped without touching its pixels.
+ *******************************************************************************
+ */
+static void _gui_image_read(struct image_reader *reader, uint8_t *out, int32_t n)
+{
+    const image_t *image = reader->image;
+    const uint8_t *row;
+    int32_t u = GUI_IMAGE_UNIT(image);
+    int32_t bits, pos, m;
+
+    if (!(image->flag & GUI_IMAGE_RLE)) {
+        if (out != Co_NULL) {
+            row  = image->data + reader->row * GUI_IMAGE_STRIDE(image);
+            bits = image_bits[image->format];
+
+            if (bits >= 8) {
+                gui_memcpy(out, row + reader->col * u, n * u);
+            }
+            else {
+                for (m = 0, pos = reader->col * bits; m < n; m++, pos += bits) {
+                    out[m] = (row[pos >> 3] >> (8 - bits - (pos & 7))) & ((1 << bits) - 1);
+                }
+            }
+        }
+
+        reader->col += n;
+        reader->row += reader->col / image->width;
+        reader->col %= image->width;
+        return;
+    }
+
+    while (n > 0) {
+        if (reader->left == 0) {
+            reader->left   = (*reader->src & 0x7F) + 1;
+            reader->repeat = (*reader->src & 0x80) != 0;
+            reader->src++;
+        }
+
+        m = MIN(n, reader->left);
+        if (reader->repeat) {
+            /* out is aligned to pixel, run data may be not */
+            if (out != Co_NULL && u == 1) {
+                gui_memset(out, *reader->src, m);
+            }
+            else if (out != Co_NULL) {
+                gui_memcpy(out, reader->src, u);
+                for (pos = 1; pos < m; pos++) {
+                    if (u == 2) {
+                        ((uint16_t *)out)[pos] = ((uint16_t *)out)[0];
+                    }
+                    else {
+                        ((uint32_t *)out)[pos] = ((uint32_t *)out)[0];
+                    }
+                }
+            }
+            if (m == reader->left) {
+                reader->src += u;
+            }
+        }
+        else {
+            if (out != Co_NULL) {
+                gui_memcpy(out, reader->src, m * u);
+            }
+            reader->src += m * u;
+        }
+
+        reader->left -= m;
+        n -= m;
+        if (out != Co_NULL) {
+            out += m * u;
+        }
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Draw a piece of image row made of pixels
+ * @param[in]  *dc      Using this DC to draw
+ * @param[in]  x        Logic x of first pixel
+ * @param[in]  y        Logic y of row
+ * @param[in]  *image   Image the pixels are from
+ * @param[in]  *units   Pixels read from image, ARGB8888 for QOI and PNG
+ * @param[in]  n        Pixels, GUI_IMAGE_CHUNK at most
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Pixels are put into format of screen, and pixels between key
+ *             or transparent pixels are drawn together.
+ *******************************************************************************
+ */
+void gui_image_put_pixels(dc_t *dc, int32_t x, int32_t y, const image_t *image,
+                          const uint8_t *units, int32_t n)
+{
+    uint32_t pixels[GUI_IMAGE_CHUNK];
+    uint32_t p;
+    int32_t  k, m, bpp;
+
+    bpp = GUI_FB_BPP(gui_graphic_driver_get_default());
+
+    for (k = 0, m = 0; k <= n; k++) {
+        if (k < n) {
+            p = (image->format == GUI_IMAGE_RGB565) ? ((const uint16_t *)units)[k] : ((const uint32_t *)units)[k];
+
+            if (GUI_IMAGE_IS_FILE(image) ? (p >> 24) >= 0x80 :
+                (!(image->flag & GUI_IMAGE_KEY) || p != image->key)) {
+                if (bpp == 4) {
+                    pixels[k] = (image->format == GUI_IMAGE_RGB565) ? gui_color_to_argb8888(p) : p | 0xFF000000;
+                }
+                else {
+                    ((uint16_t *)pixels)[k] = (image->format == GUI_IMAGE_RGB565) ? p : (uint16_t)gui_color_from_argb8888(p);
+                }
+                continue;
+            }
+        }
+
+        if (k > m) {
+            dc->engine->draw_pixels(dc, x + m, y, k - m, (uint8_t *)pixels + m * bpp, k - m);
+        }
+        m = k + 1;
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Make an image of a QOI or PNG file
+ * @param[in]  *data    Whole file
+ * @param[in]  size     Bytes of file
+ * @param[out] *image   Image of file, size is read from file header
+ * @retval     GUI_E_OK     File can be drawn
+ * @retval     GUI_E_ERROR  Not a QOI file or PNG this engine can decode
+ *
+ * @par Description
+ * @details    Only the header is checked here, file is kept where it is and
+ *             decoded when drawn. PNG must be 8 bits a channel, or palette,
+ *             not interlaced, and made with zlib window no larger than
+ *             COGUI_PNG_MAX_WINDOW.
+ *******************************************************************************
+ */
+StatusType gui_image_load(image_t *image, const uint8_t *data, uint32_t size)
+{
+    static const uint8_t png_sign[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    uint32_t width, height;
+
+    ASSERT(image != Co_NULL);
+    ASSERT(data != Co_NULL);
+
+    gui_memset(image, 0, sizeof(image_t));
+
+    /* "qoif", width, height, channels, colorspace */
+    if (size >= 14 + 8 && gui_memcmp(data, "qoif", 4) == 0) {
+        image->format = GUI_IMAGE_QOI;
+        width  = GUI_IMAGE_BE32(data + 4);
+        height = GUI_IMAGE_BE32(data + 8);
+    }
+    /* signature, IHDR length and name, width, height, depth, color type */
+    else if (size >= 8 + 25 && gui_memcmp(data, png_sign, 8) == 0 && gui_memcmp(data + 12, "IHDR", 4) == 0) {
+        image->format = GUI_IMAGE_PNG;
+        width  = GUI_IMAGE_BE32(data + 16);
+        height = GUI_IMAGE_BE32(data + 20);
+
+        /* 8 bits a channel or palette of 1, 2, 4, 8 bits, no interlace */
+        if ((data[24] != 8 && !(data[25] == 3 && (data[24] == 1 || data[24] == 2 || data[24] == 4))) ||
+            (data[25] != 0 && data[25] != 2 && data[25] != 3 && data[25] != 4 && data[25] != 6) ||
+            data[28] != 0) {
+            return GUI_E_ERROR;
+        }
+    }
+    else {
+        return GUI_E_ERROR;
+    }
+
+    if (width == 0 || height == 0 || width > 0xFFFF || height > 0xFFFF) {
+        return GUI_E_ERROR;
+    }
+
+    image->width  = (uint16_t)width;
+    image->height = (uint16_t)height;
+    image->data   = data;
+    image->size   = size;
+
+    return GUI_E_OK;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Draw an image
+ * @param[in]  *dc      Using this DC to draw
+ * @param[in]  x        Logic x of image left
+ * @param[in]  y        Logic y of image top
+ * @param[in]  *image   Image to draw
+ * @param[out] None
+ * @retval     GUI_E_OK     Image is drawn
+ * @retval     GUI_E_ERROR  Bad QOI or PNG data, or no memory to decode it
+ *
+ * @par Description
+ * @details    Image is cut by DC bound first and decoded row by row, a few
+ *             pixels at a time, so no buffer of whole image is needed. Rows
+ *             of screen format without key are copied from image directly.
+ *******************************************************************************
+ */
+StatusType gui_dc_draw_image(dc_t *dc, int32_t x, int32_t y, const image_t *image)
+{
+    struct image_reader reader;
+    uint32_t units[GUI_IMAGE_CHUNK];
+    const uint8_t *row;
+    int32_t  i, i2, j, j1, j2, n, u;
+    bool_t   direct;
+    rect_t   bound;
+
+    ASSERT(dc != Co_NULL);
+    ASSERT(image != Co_NULL && image->data != Co_NULL);
+    ASSERT(!GUI_IMAGE_IS_INDEXED(image) || image->palette != Co_NULL);
+
+    gui_dc_get_bound(dc, &bound);
+
+    i  = MAX(bound.y1 - y, 0);
+    i2 = MIN(bound.y2 - y, image->height);
+    j1 = MAX(bound.x1 - x, 0);
+    j2 = MIN(bound.x2 - x, image->width);
+    if (i >= i2 || j1 >= j2) {
+        return GUI_E_OK;
+    }
+
+    if (image->format == GUI_IMAGE_QOI) {
+        return gui_image_draw_qoi(dc, x, y, image, &bound);
+    }
+    if (image->format == GUI_IMAGE_PNG) {
+        return gui_image_draw_png(dc, x, y, image, &bound);
+    }
+
+    u = GUI_IMAGE_UNIT(image);
+
+    /* plain bytes or pixels of screen format need no decoding */
+    direct = !(image->flag & GUI_IMAGE_RLE) &&
+             (image->format == GUI_IMAGE_INDEX8 ||
+              (!(image->flag & GUI_IMAGE_KEY) && !GUI_IMAGE_IS_INDEXED(image) &&
+               u == GUI_FB_BPP(gui_graphic_driver_get_default())));
+
+    if (direct) {
+        for (; i < i2; i++) {
+            row = image->data + i * GUI_IMAGE_STRIDE(image) + j1 * u;
+
+            if (GUI_IMAGE_IS_INDEXED(image)) {
+                dc->engine->draw_indexed(dc, x + j1, y + i, j2 - j1, 1, row, image->palette,
+                                         (image->flag & GUI_IMAGE_KEY) ? (int32_t)image->key : -1);
+            }
+            else {
+                dc->engine->draw_pixels(dc, x + j1, y + i, j2 - j1, row, j2 - j1);
+            }
+        }
+        return GUI_E_OK;
+    }
+
+    gui_memset(&reader, 0, sizeof(reader));
+    reader.image = image;
+    reader.src   = image->data;
+
+    /* go to first pixel in bound */
+    _gui_image_read(&reader, Co_NULL, i * image->width + j1);
+
+    for (; i < i2; i++) {
+        for (j = j1; j < j2; j += n) {
+            n = MIN(j2 - j, GUI_IMAGE_CHUNK);
+            _gui_image_read(&reader, (uint8_t *)units, n);
+
+            if (GUI_IMAGE_IS_INDEXED(image)) {
+                dc->engine->draw_indexed(dc, x + j, y + i, n, 1, (uint8_t *)units, image->palette,
+                                         (image->flag & GUI_IMAGE_KEY) ? (int32_t)image->key : -1);
+            }
+            else {
+                gui_image_put_pixels(dc, x + j, y + i, image, (uint8_t *)units, n);
+            }
+        }
+
+        /* pixels out of bound, to first pixel in bound of next row */
+        if (i + 1 < i2) {
+            _gui_image_read(&reader, Co_NULL, image->width - (j2 - j1));
+        }
+    }
+
+    return GUI_E_OK;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Read a piece of image row as ARGB8888
+ * @param[in]  *reader  Place to read from
+ * @param[in]  *pos     Pixels gone by reader
+ * @param[in]  row      Row to read, below rows read before
+ * @param[in]  col      First column to read
+ * @param[in]  n        Pixels to read
+ * @param[out] *out     Pixels, 0 for key and alpha 0xFF for others
+ * @param[out] *pos     Pixels gone by reader after reading
+ * @retval     None
+ *******************************************************************************
+ */
+static void _gui_image_read_argb(struct image_reader *reader, int32_t *pos, int32_t row,
+                                 int32_t col, int32_t n, uint32_t *out)
+{
+    const image_t *image = reader->image;
+    uint32_t units[GUI_IMAGE_CHUNK];
+    uint32_t p;
+    int32_t  k, j, m;
+
+    _gui_image_read(reader, Co_NULL, row * image->width + col - *pos);
+    *pos = row * image->width + col + n;
+
+    for (k = 0; k < n; k += m) {
+        m = MIN(n - k, GUI_IMAGE_CHUNK);
+        _gui_image_read(reader, (uint8_t *)units, m);
+
+        for (j = 0; j < m; j++) {
+            if (GUI_IMAGE_IS_INDEXED(image)) {
+                p = ((uint8_t *)units)[j];
+            }
+            else {
+                p = (image->format == GUI_IMAGE_RGB565) ? ((uint16_t *)units)[j] : units[j];
+            }
+
+            if ((image->flag & GUI_IMAGE_KEY) && p == image->key) {
+                out[k + j] = 0;
+            }
+            else if (GUI_IMAGE_IS_INDEXED(image)) {
+                out[k + j] = gui_color_to_argb8888(image->palette[p]) | 0xFF000000;
+            }
+            else {
+                out[k + j] = ((image->format == GUI_IMAGE_RGB565) ? gui_color_to_argb8888(p) : p) | 0xFF000000;
+            }
+        }
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Mix two ARGB8888 pixels
+ * @param[in]  a        First pixel
+ * @param[in]  b        Second pixel
+ * @param[in]  f        Weight of second pixel, 0 to 255 of 256
+ * @param[out] None
+ * @retval     pixel    Mixed pixel
+ *
+ * @par Description
+ * @details    Red and blue, then alpha and green are mixed together, each
+ *             pair by one multiply as they are 16 bits apart in a word. A
+ *             transparent pixel takes color of the other one, so color of
+ *             key is not brought in.
+ *******************************************************************************
+ */
+static uint32_t _gui_image_mix(uint32_t a, uint32_t b, uint32_t f)
+{
+    uint32_t rb, ag;
+
+    if ((a >> 24) == 0) {
+        a = b & 0x00FFFFFF;
+    }
+    else if ((b >> 24) == 0) {
+        b = a & 0x00FFFFFF;
+    }
+
+    rb = ((a & 0x00FF00FF) * (256 - f) + (b & 0x00FF00FF) * f) >> 8;
+    ag = ((a >> 8) & 0x00FF00FF) * (256 - f) + ((b >> 8) & 0x00FF00FF) * f;
+
+    return (rb & 0x00FF00FF) | (ag & 0xFF00FF00);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Get source place of a scaled pixel
+ * @param[in]  u        Center of pixel in source, 16.16 fixed point
+ * @param[in]  size     Source width or height
+ * @param[in]  filter   GUI_IMAGE_NEAREST or GUI_IMAGE_BILINEAR
+ * @param[out] None
+ * @retval     place    Place to take pixel, 16.16 fixed point
+ *
+ * @par Description
+ * @details    Nearest place is the source pixel center falls in. Bilinear
+ *             place is between centers of source pixels, so it is half a
+ *             pixel less and kept inside first and last center.
+ *******************************************************************************
+ */
+static uint32_t _gui_image_place(uint32_t u, int32_t size, uint8_t filter)
+{
+    if (filter == GUI_IMAGE_NEAREST) {
+        return u & 0xFFFF0000;
+    }
+
+    return (u < 0x8000) ? 0 : MIN(u - 0x8000, (uint32_t)(size - 1) << 16);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Draw an image scaled to a rectangle
+ * @param[in]  *dc      Using this DC to draw
+ * @param[in]  *rect    Rectangle image is scaled to
+ * @param[in]  *image   Image to draw, not QOI or PNG
+ * @param[in]  filter   GUI_IMAGE_NEAREST or GUI_IMAGE_BILINEAR
+ * @param[out] None
+ * @retval     GUI_E_OK     Image is drawn
+ * @retval     GUI_E_ERROR  QOI or PNG image, or no memory for source rows
+ *
+ * @par Description
+ * @details    Rectangle is cut by DC bound first, and source place of each
+ *             pixel left is stepped in 16.16 fixed point from there. Only
+ *             the source columns under it are read, a row once, and kept
+ *             in two rows for bilinear filter. The two rows are mixed once
+ *             a line, then pixels along it.
+ *******************************************************************************
+ */
+StatusType gui_dc_draw_image_scaled(dc_t *dc, rect_t *rect, const image_t *image, uint8_t filter)
+{
+    /* scaled pixels are put as ARGB8888, 0 is transparent */
+    static const image_t scaled = { GUI_IMAGE_ARGB8888, GUI_IMAGE_KEY, 0, 0, 0, Co_NULL, Co_NULL, 0 };
+    struct image_reader reader;
+    uint32_t units[GUI_IMAGE_CHUNK];
+    uint32_t *rows, *row0, *row1, *line, *tmp;
+    uint32_t step_x, step_y, u, v, p;
+    int32_t  i, i2, j, j1, j2, k, n, c0, span, r0, r1, have0, have1, pos;
+    rect_t   bound;
+
+    ASSERT(dc != Co_NULL);
+    ASSERT(image != Co_NULL && image->data != Co_NULL);
+    ASSERT(!GUI_IMAGE_IS_INDEXED(image) || image->palette != Co_NULL);
+
+    if (rect == Co_NULL || GUI_RECT_IS_EMPTY(rect)) {
+        return GUI_E_OK;
+    }
+    if (GUI_IMAGE_IS_FILE(image)) {
+        return GUI_E_ERROR;
+    }
+
+    gui_dc_get_bound(dc, &bound);
+
+    i  = MAX(rect->y1, bound.y1);
+    i2 = MIN(rect->y2, bound.y2);
+    j1 = MAX(rect->x1, bound.x1);
+    j2 = MIN(rect->x2, bound.x2);
+    if (i >= i2 || j1 >= j2) {
+        return GUI_E_OK;
+    }
+
+    step_x = ((uint32_t)image->width << 16) / GUI_RECT_WIDTH(rect);
+    step_y = ((uint32_t)image->height << 16) / GUI_RECT_HEIGHT(rect);
+
+    /* source columns under pixels left */
+    c0   = _gui_image_place((j1 - rect->x1) * step_x + step_x / 2, image->width, filter) >> 16;
+    v    = _gui_image_place((j2 - 1 - rect->x1) * step_x + step_x / 2, image->width, filter);
+    span = (v >> 16) + ((v & 0xFF00) != 0) - c0 + 1;
+
+    /* upper and lower source row, and the two mixed */
+    rows = gui_malloc(span * sizeof(uint32_t) * ((filter == GUI_IMAGE_NEAREST) ? 1 : 3));
+    if (rows == Co_NULL) {
+        return GUI_E_ERROR;
+    }
+    row0 = rows;
+    row1 = rows + span;
+
+    gui_memset(&reader, 0, sizeof(reader));
+    reader.image = image;
+    reader.src   = image->data;
+    pos   = 0;
+    have0 = -1;
+    have1 = -1;
+
+    for (; i < i2; i++) {
+        v  = _gui_image_place((i - rect->y1) * step_y + step_y / 2, image->height, filter);
+        r0 = v >> 16;
+        r1 = r0 + ((v & 0xFF00) != 0);
+
+        /* rows go down only, last lower row may be upper row now */
+        if (r0 != have0 && r0 == have1) {
+            tmp   = row0;
+            row0  = row1;
+            row1  = tmp;
+            have1 = have0;
+            have0 = r0;
+        }
+        else if (r0 != have0) {
+            _gui_image_read_argb(&reader, &pos, r0, c0, span, row0);
+            have0 = r0;
+        }
+        if (r1 != r0 && r1 != have1) {
+            _gui_image_read_argb(&reader, &pos, r1, c0, span, row1);
+            have1 = r1;
+        }
+
+        line = row0;
+        if (r1 != r0) {
+            line = rows + 2 * span;
+            for (k = 0; k < span; k++) {
+                line[k] = _gui_image_mix(row0[k], row1[k], (v >> 8) & 0xFF);
+            }
+        }
+
+        u = (j1 - rect->x1) * step_x + step_x / 2;
+        for (j = j1; j < j2; j += n) {
+            n = MIN(j2 - j, GUI_IMAGE_CHUNK);
+
+            for (k = 0; k < n; k++, u += step_x) {
+                v = _gui_image_place(u, image->width, filter);
+                p = line[(v >> 16) - c0];
+                if (v & 0xFF00) {
+                    p = _gui_image_mix(p, line[(v >> 16) - c0 + 1], (v >> 8) & 0xFF);
+                }
+                units[k] = ((p >> 24) >= 0x80) ? p | 0xFF000000 : 0;
+            }
+
+            gui_image_put_pixels(dc, j, i, &scaled, (uint8_t *)units, n);
+        }
+    }
+
+    gui_free(rows);
+
+    return GUI_E_OK;
+}
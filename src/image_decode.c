@@ -0,0 +1,788 @@
+/**
+ *******************************************************************************
+ * @file       image_decode.c
+ * @version    V0.7.4
+ * @date       2020.04.18
+ * @brief      QOI and PNG decoding function for GUI engine.
+ *******************************************************************************
+ */
+
+#include <cogui.h>
+
+/* QOI chunk tags */
+#define QOI_OP_INDEX          0x00
+#define QOI_OP_DIFF           0x40
+#define QOI_OP_LUMA           0x80
+#define QOI_OP_RUN            0xC0
+#define QOI_OP_RGB            0xFE
+#define QOI_OP_RGBA           0xFF
+
+/* QOI header and end marker */
+#define QOI_HEADER_SIZE       14
+#define QOI_PADDING_SIZE      8
+
+/* state of deflate stream */
+#define PNG_BLOCK_HEADER      0x00          /**< next is a block header        */
+#define PNG_BLOCK_STORED      0x01          /**< in a stored block             */
+#define PNG_BLOCK_HUFFMAN     0x02          /**< in a coded block              */
+#define PNG_BLOCK_DONE        0x03          /**< last block is over            */
+
+/**
+ * @struct   png_huffman image_decode.c
+ * @brief    Huffman code struct
+ * @details  This struct is a canonical code, how many codes of each length
+ *           and symbols in order of code.
+ */
+struct png_huffman
+{
+    int16_t           count[16];            /**< codes of each length           */
+    int16_t           symbol[288];          /**< symbols sorted by code         */
+};
+
+/**
+ * @struct   png_decoder image_decode.c
+ * @brief    PNG decoder struct
+ * @details  This struct is state of inflating IDAT data. It is allocated
+ *           with the zlib window and two rows after it, and freed after
+ *           drawing.
+ */
+struct png_decoder
+{
+    const uint8_t *   src;                  /**< next byte of IDAT chunk        */
+    const uint8_t *   end;                  /**< end of IDAT chunk              */
+    const uint8_t *   file_end;             /**< end of file                    */
+    uint32_t          bits;                 /**< bits read but not used         */
+    int32_t           bit_cnt;              /**< how many bits read not used    */
+    bool_t            error;                /**< data is bad                    */
+
+    uint8_t           mode;                 /**< PNG_BLOCK_HEADER and so on     */
+    uint8_t           last;                 /**< current block is the last one  */
+    int32_t           left;                 /**< bytes left to store or copy    */
+    uint32_t          dist;                 /**< distance of bytes to copy      */
+    uint8_t *         window;               /**< bytes inflated last            */
+    uint32_t          mask;                 /**< window size minus 1            */
+    uint32_t          pos;                  /**< next place in window           */
+    struct png_huffman lencode;             /**< literal and length code        */
+    struct png_huffman distcode;            /**< distance code                  */
+
+    uint8_t           type;                 /**< color type of PNG              */
+    uint8_t           depth;                /**< bits a sample                  */
+    const uint8_t *   plte;                 /**< palette, 3 bytes an entry      */
+    uint32_t          plte_cnt;             /**< entries in palette             */
+    const uint8_t *   trns;                 /**< transparency chunk             */
+    uint32_t          trns_len;             /**< bytes of transparency chunk    */
+};
+
+/* length and distance of copy, base and extra bits */
+static const uint16_t png_len_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const uint8_t png_len_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const uint16_t png_dist_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+static const uint8_t png_dist_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+/* order of code length code lengths */
+static const uint8_t png_clen_order[19] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+/* channels of PNG color type */
+static const uint8_t png_channels[7] = { 1, 0, 3, 1, 2, 0, 4 };
+
+/**
+ *******************************************************************************
+ * @brief      Draw a QOI image
+ * @param[in]  *dc      Using this DC to draw
+ * @param[in]  x        Logic x of image left
+ * @param[in]  y        Logic y of image top
+ * @param[in]  *image   QOI image
+ * @param[in]  *bound   Bound of DC, image is drawn inside
+ * @param[out] None
+ * @retval     GUI_E_OK     Image is drawn
+ * @retval     GUI_E_ERROR  Data ends before image
+ *
+ * @par Description
+ * @details    Pixels are decoded one after another and put to DC a chunk at
+ *             a time. Rows under bound are not decoded. Only the 64 pixels
+ *             index of QOI is kept.
+ *******************************************************************************
+ */
+StatusType gui_image_draw_qoi(dc_t *dc, int32_t x, int32_t y, const image_t *image, rect_t *bound)
+{
+    uint32_t index[64];
+    uint32_t units[GUI_IMAGE_CHUNK];
+    const uint8_t *src, *end;
+    uint32_t px, c, r, g, b, a;
+    int32_t  i, i1, i2, j, j1, j2, n, run;
+
+    i1 = MAX(bound->y1 - y, 0);
+    i2 = MIN(bound->y2 - y, image->height);
+    j1 = MAX(bound->x1 - x, 0);
+    j2 = MIN(bound->x2 - x, image->width);
+
+    src = image->data + QOI_HEADER_SIZE;
+    end = image->data + image->size - QOI_PADDING_SIZE;
+
+    gui_memset(index, 0, sizeof(index));
+    px  = 0xFF000000;
+    run = 0;
+
+    for (i = 0; i < i2; i++) {
+        for (j = 0, n = 0; j < image->width; j++) {
+            if (run > 0) {
+                run--;
+            }
+            else {
+                if (src >= end) {
+                    return GUI_E_ERROR;
+                }
+
+                c = *src++;
+                if (c == QOI_OP_RGB || c == QOI_OP_RGBA) {
+                    a  = (c == QOI_OP_RGBA) ? src[3] : (px >> 24);
+                    px = (a << 24) | ((uint32_t)src[0] << 16) | ((uint32_t)src[1] << 8) | src[2];
+                    src += (c == QOI_OP_RGBA) ? 4 : 3;
+                }
+                else if ((c & 0xC0) == QOI_OP_INDEX) {
+                    px = index[c];
+                }
+                else if ((c & 0xC0) == QOI_OP_RUN) {
+                    run = c & 0x3F;
+                }
+                else {
+                    /* difference to last pixel, green and the others to it */
+                    if ((c & 0xC0) == QOI_OP_DIFF) {
+                        g = ((c >> 2) & 3) - 2;
+                        r = ((c >> 4) & 3) - 2;
+                        b = (c & 3) - 2;
+                    }
+                    else {
+                        g = (c & 0x3F) - 32;
+                        r = g + (*src >> 4) - 8;
+                        b = g + (*src & 0x0F) - 8;
+                        src++;
+                    }
+                    px = (px & 0xFF000000) | ((((px >> 16) + r) & 0xFF) << 16) |
+                         ((((px >> 8) + g) & 0xFF) << 8) | ((px + b) & 0xFF);
+                }
+
+                r = (px >> 16) & 0xFF;
+                g = (px >> 8) & 0xFF;
+                b = px & 0xFF;
+                a = px >> 24;
+                index[(r * 3 + g * 5 + b * 7 + a * 11) & 63] = px;
+            }
+
+            /* rows over bound are decoded only */
+            if (i >= i1 && j >= j1 && j < j2) {
+                units[n++] = px;
+                if (n == GUI_IMAGE_CHUNK || j == j2 - 1) {
+                    gui_image_put_pixels(dc, x + j + 1 - n, y + i, image, (uint8_t *)units, n);
+                    n = 0;
+                }
+            }
+        }
+    }
+
+    return GUI_E_OK;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Get next byte of IDAT data
+ * @param[in]  *png     PNG decoder
+ * @param[out] None
+ * @retval     byte     Next byte, 0 if there is no more
+ *
+ * @par Description
+ * @details    Data goes on in next chunk if it is IDAT too.
+ *******************************************************************************
+ */
+static uint32_t _gui_png_byte(struct png_decoder *png)
+{
+    const uint8_t *chunk;
+
+    while (png->src == png->end) {
+        /* skip CRC of chunk over */
+        chunk = png->end + 4;
+        if (chunk + 8 > png->file_end || gui_memcmp(chunk + 4, "IDAT", 4) != 0 ||
+            GUI_IMAGE_BE32(chunk) > (uint32_t)(png->file_end - chunk - 8)) {
+            png->error = 1;
+            return 0;
+        }
+
+        png->src = chunk + 8;
+        png->end = png->src + GUI_IMAGE_BE32(chunk);
+    }
+
+    return *png->src++;
+}
+
+static uint32_t _gui_png_bits(struct png_decoder *png, int32_t n)
+{
+    uint32_t val;
+
+    while (png->bit_cnt < n) {
+        png->bits |= _gui_png_byte(png) << png->bit_cnt;
+        png->bit_cnt += 8;
+    }
+
+    val = png->bits & ((1UL << n) - 1);
+    png->bits >>= n;
+    png->bit_cnt -= n;
+
+    return val;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Make canonical Huffman code from code lengths
+ * @param[in]  *length  Code length of each symbol, 0 if not used
+ * @param[in]  n        Number of symbols
+ * @param[out] *h       Huffman code
+ * @retval     1        Code is made
+ * @retval     0        Lengths give more codes than bits can hold
+ *******************************************************************************
+ */
+static bool_t _gui_png_huffman(struct png_huffman *h, const uint8_t *length, int32_t n)
+{
+    int16_t offs[16];
+    int32_t left, len, s;
+
+    gui_memset(h->count, 0, sizeof(h->count));
+    for (s = 0; s < n; s++) {
+        h->count[length[s]]++;
+    }
+
+    for (len = 1, left = 1; len < 16; len++) {
+        left = (left << 1) - h->count[len];
+        if (left < 0) {
+            return 0;
+        }
+    }
+
+    for (len = 1, offs[1] = 0; len < 15; len++) {
+        offs[len + 1] = offs[len] + h->count[len];
+    }
+
+    for (s = 0; s < n; s++) {
+        if (length[s] != 0) {
+            h->symbol[offs[length[s]]++] = s;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Decode a symbol
+ * @param[in]  *png     PNG decoder
+ * @param[in]  *h       Huffman code to use
+ * @param[out] None
+ * @retval     symbol   Symbol decoded, 0 if data is bad
+ *
+ * @par Description
+ * @details    Code is read one bit a time, first bit is the highest one, and
+ *             compared with the first code of its length. Bits left in hand
+ *             are used in a local loop before a new byte is taken.
+ *******************************************************************************
+ */
+static int32_t _gui_png_decode(struct png_decoder *png, const struct png_huffman *h)
+{
+    const int16_t *count = h->count + 1;
+    int32_t  code, first, index, len, left;
+    uint32_t bits;
+
+    code = first = index = 0;
+    len  = 1;
+    bits = png->bits;
+    left = png->bit_cnt;
+
+    for (;;) {
+        while (left--) {
+            code |= bits & 1;
+            bits >>= 1;
+
+            if (code - *count < first) {
+                png->bits    = bits;
+                png->bit_cnt = (png->bit_cnt - len) & 7;
+                return h->symbol[index + (code - first)];
+            }
+
+            index += *count;
+            first  = (first + *count) << 1;
+            code <<= 1;
+            count++;
+            len++;
+        }
+
+        left = 16 - len;
+        if (left <= 0) {
+            break;
+        }
+        bits = _gui_png_byte(png);
+        left = MIN(left, 8);
+    }
+
+    png->error = 1;
+    return 0;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Read header of a deflate block
+ * @param[in]  *png     PNG decoder
+ * @param[out] *png     Mode and code of the block
+ * @retval     None
+ *******************************************************************************
+ */
+static void _gui_png_block(struct png_decoder *png)
+{
+    uint8_t lengths[286 + 30];
+    int32_t nlen, ndist, ncode, index, sym, len, rep;
+
+    png->last = (uint8_t)_gui_png_bits(png, 1);
+
+    switch (_gui_png_bits(png, 2)) {
+        case 0:
+            /* stored block starts on a byte */
+            png->bits >>= png->bit_cnt & 7;
+            png->bit_cnt -= png->bit_cnt & 7;
+
+            png->left = _gui_png_bits(png, 16);
+            if ((uint32_t)png->left != (~_gui_png_bits(png, 16) & 0xFFFF)) {
+                png->error = 1;
+            }
+            png->mode = PNG_BLOCK_STORED;
+            return;
+
+        case 1:
+            /* fixed code */
+            for (sym = 0; sym < 288; sym++) {
+                lengths[sym] = (sym < 144) ? 8 : (sym < 256) ? 9 : (sym < 280) ? 7 : 8;
+            }
+            _gui_png_huffman(&png->lencode, lengths, 288);
+
+            for (sym = 0; sym < 30; sym++) {
+                lengths[sym] = 5;
+            }
+            _gui_png_huffman(&png->distcode, lengths, 30);
+
+            png->mode = PNG_BLOCK_HUFFMAN;
+            return;
+
+        case 2:
+            nlen  = _gui_png_bits(png, 5) + 257;
+            ndist = _gui_png_bits(png, 5) + 1;
+            ncode = _gui_png_bits(png, 4) + 4;
+            if (nlen > 286 || ndist > 30) {
+                break;
+            }
+
+            /* code of code lengths, kept in distance code for a while */
+            gui_memset(lengths, 0, 19);
+            for (index = 0; index < ncode; index++) {
+                lengths[png_clen_order[index]] = (uint8_t)_gui_png_bits(png, 3);
+            }
+            if (!_gui_png_huffman(&png->distcode, lengths, 19)) {
+                break;
+            }
+
+            for (index = 0; index < nlen + ndist && !png->error; ) {
+                sym = _gui_png_decode(png, &png->distcode);
+                if (sym < 16) {
+                    lengths[index++] = (uint8_t)sym;
+                    continue;
+                }
+
+                /* 16 repeats last length, 17 and 18 repeat zero */
+                if (sym == 16) {
+                    if (index == 0) {
+                        break;
+                    }
+                    len = lengths[index - 1];
+                    rep = 3 + _gui_png_bits(png, 2);
+                }
+                else {
+                    len = 0;
+                    rep = (sym == 17) ? 3 + _gui_png_bits(png, 3) : 11 + _gui_png_bits(png, 7);
+                }
+
+                if (index + rep > nlen + ndist) {
+                    break;
+                }
+                while (rep--) {
+                    lengths[index++] = (uint8_t)len;
+                }
+            }
+
+            if (index < nlen + ndist || lengths[256] == 0 ||
+                !_gui_png_huffman(&png->lencode, lengths, nlen) ||
+                !_gui_png_huffman(&png->distcode, lengths + nlen, ndist)) {
+                break;
+            }
+
+            png->mode = PNG_BLOCK_HUFFMAN;
+            return;
+
+        default:
+            break;
+    }
+
+    png->error = 1;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Inflate IDAT data
+ * @param[in]  *png     PNG decoder
+ * @param[in]  n        Bytes wanted
+ * @param[out] *out     Bytes inflated
+ * @retval     None
+ *
+ * @par Description
+ * @details    Inflating stops at any byte and goes on in next call, so rows
+ *             are taken one by one. Every byte is kept in window too, which
+ *             copies are made from.
+ *******************************************************************************
+ */
+static void _gui_png_inflate(struct png_decoder *png, uint8_t *out, int32_t n)
+{
+    int32_t  sym, m;
+    uint32_t c;
+
+    while (n > 0 && !png->error) {
+        if (png->left > 0) {
+            /* stored bytes or a copy, as many as wanted in one go */
+            m = MIN(n, png->left);
+            png->left -= m;
+            n -= m;
+            while (m--) {
+                c = (png->mode == PNG_BLOCK_STORED) ? _gui_png_bits(png, 8) :
+                    png->window[(png->pos - png->dist) & png->mask];
+                png->window[png->pos] = (uint8_t)c;
+                png->pos = (png->pos + 1) & png->mask;
+                *out++ = (uint8_t)c;
+            }
+            continue;
+        }
+        else if (png->mode == PNG_BLOCK_HEADER) {
+            _gui_png_block(png);
+            continue;
+        }
+        else if (png->mode == PNG_BLOCK_HUFFMAN) {
+            sym = _gui_png_decode(png, &png->lencode);
+            if (sym < 256) {
+                c = sym;
+            }
+            else if (sym == 256) {
+                png->mode = png->last ? PNG_BLOCK_DONE : PNG_BLOCK_HEADER;
+                continue;
+            }
+            else {
+                sym -= 257;
+                if (sym >= 29) {
+                    png->error = 1;
+                    return;
+                }
+                png->left = png_len_base[sym] + _gui_png_bits(png, png_len_extra[sym]);
+
+                sym = _gui_png_decode(png, &png->distcode);
+                if (sym >= 30) {
+                    png->error = 1;
+                    return;
+                }
+                png->dist = png_dist_base[sym] + _gui_png_bits(png, png_dist_extra[sym]);
+                if (png->dist > png->mask + 1) {
+                    png->error = 1;
+                }
+                continue;
+            }
+        }
+        else if (png->mode == PNG_BLOCK_STORED) {
+            png->mode = png->last ? PNG_BLOCK_DONE : PNG_BLOCK_HEADER;
+            continue;
+        }
+        else {
+            /* stream is over before image */
+            png->error = 1;
+            return;
+        }
+
+        png->window[png->pos] = (uint8_t)c;
+        png->pos = (png->pos + 1) & png->mask;
+        *out++ = (uint8_t)c;
+        n--;
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Undo filter of a row
+ * @param[in]  filter   Filter type of row
+ * @param[in]  *prev    Row over it, unfiltered
+ * @param[in]  stride   Bytes of row
+ * @param[in]  bpp      Bytes a pixel, 1 at least
+ * @param[out] *row     Row unfiltered
+ * @retval     1        Row is unfiltered
+ * @retval     0        Unknown filter
+ *******************************************************************************
+ */
+static bool_t _gui_png_unfilter(uint32_t filter, uint8_t *row, const uint8_t *prev,
+                                int32_t stride, int32_t bpp)
+{
+    int32_t k, a, b, c, p, pa, pb, pc;
+
+    switch (filter) {
+        case 0:
+            break;
+
+        case 1:
+            for (k = bpp; k < stride; k++) {
+                row[k] += row[k - bpp];
+            }
+            break;
+
+        case 2:
+            for (k = 0; k < stride; k++) {
+                row[k] += prev[k];
+            }
+            break;
+
+        case 3:
+            /* first pixel has nothing on its left */
+            for (k = 0; k < bpp; k++) {
+                row[k] += prev[k] >> 1;
+            }
+            for (; k < stride; k++) {
+                row[k] += (row[k - bpp] + prev[k]) >> 1;
+            }
+            break;
+
+        case 4:
+            /* Paeth, the one of left, up and up left nearest to their sum */
+            for (k = 0; k < bpp; k++) {
+                row[k] += prev[k];
+            }
+            for (; k < stride; k++) {
+                a  = row[k - bpp];
+                b  = prev[k];
+                c  = prev[k - bpp];
+                p  = b - c;
+                pc = a - c;
+                pa = (p < 0) ? -p : p;
+                pb = (pc < 0) ? -pc : pc;
+                pc = (p + pc < 0) ? -(p + pc) : p + pc;
+                row[k] += (pa <= pb && pa <= pc) ? a : (pb <= pc) ? b : c;
+            }
+            break;
+
+        default:
+            return 0;
+    }
+
+    return 1;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Get a pixel of PNG row
+ * @param[in]  *png     PNG decoder
+ * @param[in]  *row     Row unfiltered
+ * @param[in]  j        Column of pixel
+ * @param[out] None
+ * @retval     pixel    Pixel in ARGB8888
+ *******************************************************************************
+ */
+static uint32_t _gui_png_pixel(struct png_decoder *png, const uint8_t *row, int32_t j)
+{
+    const uint8_t *p;
+    uint32_t v, a = 0xFF;
+
+    switch (png->type) {
+        case 0:
+            v = row[j];
+            if (png->trns_len >= 2 && png->trns[0] == 0 && png->trns[1] == v) {
+                a = 0;
+            }
+            return (a << 24) | (v * 0x010101);
+
+        case 2:
+            p = &row[j * 3];
+            if (png->trns_len >= 6 && png->trns[0] == 0 && png->trns[1] == p[0] && png->trns[2] == 0 &&
+                png->trns[3] == p[1] && png->trns[4] == 0 && png->trns[5] == p[2]) {
+                a = 0;
+            }
+            return (a << 24) | ((uint32_t)p[0] << 16) | ((uint32_t)p[1] << 8) | p[2];
+
+        case 3:
+            j *= png->depth;
+            v  = (row[j >> 3] >> (8 - png->depth - (j & 7))) & ((1 << png->depth) - 1);
+            if (v >= png->plte_cnt) {
+                return 0xFF000000;
+            }
+            if (v < png->trns_len) {
+                a = png->trns[v];
+            }
+            p = &png->plte[v * 3];
+            return (a << 24) | ((uint32_t)p[0] << 16) | ((uint32_t)p[1] << 8) | p[2];
+
+        case 4:
+            return ((uint32_t)row[j * 2 + 1] << 24) | (row[j * 2] * 0x010101);
+
+        default:
+            p = &row[j * 4];
+            return ((uint32_t)p[3] << 24) | ((uint32_t)p[0] << 16) | ((uint32_t)p[1] << 8) | p[2];
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Draw a PNG image
+ * @param[in]  *dc      Using this DC to draw
+ * @param[in]  x        Logic x of image left
+ * @param[in]  y        Logic y of image top
+ * @param[in]  *image   PNG image
+ * @param[in]  *bound   Bound of DC, image is drawn inside
+ * @param[out] None
+ * @retval     GUI_E_OK     Image is drawn
+ * @retval     GUI_E_ERROR  Bad or unsupported data, or no memory
+ *
+ * @par Description
+ * @details    Rows are inflated and unfiltered one by one, only the zlib
+ *             window and two rows are kept. Rows under bound are not
+ *             inflated. Smaller window in zlib header takes less memory.
+ *******************************************************************************
+ */
+StatusType gui_image_draw_png(dc_t *dc, int32_t x, int32_t y, const image_t *image, rect_t *bound)
+{
+    struct png_decoder *png;
+    const uint8_t *chunk, *idat = Co_NULL;
+    const uint8_t *file_end = image->data + image->size;
+    uint32_t units[GUI_IMAGE_CHUNK];
+    uint32_t len, window;
+    uint8_t  *row, *prev, *tmp, filter, zlib[2];
+    int32_t  i, i1, i2, j, j1, j2, n, stride, bpp;
+    uint8_t  type, depth;
+    StatusType result;
+
+    i1 = MAX(bound->y1 - y, 0);
+    i2 = MIN(bound->y2 - y, image->height);
+    j1 = MAX(bound->x1 - x, 0);
+    j2 = MIN(bound->x2 - x, image->width);
+
+    depth = image->data[24];
+    type  = image->data[25];
+    if (type > 6 || png_channels[type] == 0 ||
+        (depth != 8 && !(type == 3 && (depth == 1 || depth == 2 || depth == 4)))) {
+        return GUI_E_ERROR;
+    }
+
+    /* palette and transparency come before first IDAT */
+    for (chunk = image->data + 8; chunk + 12 <= file_end; chunk += 12 + len) {
+        len = GUI_IMAGE_BE32(chunk);
+        if (len > (uint32_t)(file_end - chunk - 12)) {
+            return GUI_E_ERROR;
+        }
+        if (gui_memcmp(chunk + 4, "IDAT", 4) == 0) {
+            idat = chunk;
+            break;
+        }
+    }
+
+    /* zlib header may be cut into two IDAT chunks */
+    for (chunk = idat, n = 0; n < 2 && chunk != Co_NULL && chunk + 12 <= file_end &&
+         gui_memcmp(chunk + 4, "IDAT", 4) == 0; chunk += 12 + len) {
+        len = GUI_IMAGE_BE32(chunk);
+        if (len > (uint32_t)(file_end - chunk - 12)) {
+            return GUI_E_ERROR;
+        }
+        for (j = 0; j < (int32_t)len && n < 2; j++) {
+            zlib[n++] = chunk[8 + j];
+        }
+    }
+
+    /* zlib header: deflate, window size, no dictionary */
+    if (n < 2 || (zlib[0] & 0x0F) != 8 || (zlib[1] & 0x20) || ((zlib[0] << 8) | zlib[1]) % 31 != 0) {
+        return GUI_E_ERROR;
+    }
+    window = 1UL << ((zlib[0] >> 4) + 8);
+    if (window > COGUI_PNG_MAX_WINDOW) {
+        return GUI_E_ERROR;
+    }
+
+    stride = ((int32_t)image->width * png_channels[type] * depth + 7) >> 3;
+    bpp    = MAX(png_channels[type] * depth / 8, 1);
+
+    png = gui_malloc(sizeof(struct png_decoder) + window + 2 * stride);
+    if (png == Co_NULL) {
+        return GUI_E_ERROR;
+    }
+    gui_memset(png, 0, sizeof(struct png_decoder));
+
+    png->type     = type;
+    png->depth    = depth;
+    png->file_end = file_end;
+    png->window   = (uint8_t *)(png + 1);
+    png->mask     = window - 1;
+    png->mode     = PNG_BLOCK_HEADER;
+    png->src      = idat + 8;
+    png->end      = idat + 8 + GUI_IMAGE_BE32(idat);
+    _gui_png_bits(png, 16);
+
+    for (chunk = image->data + 8; chunk < idat; chunk += 12 + GUI_IMAGE_BE32(chunk)) {
+        if (gui_memcmp(chunk + 4, "PLTE", 4) == 0) {
+            png->plte     = chunk + 8;
+            png->plte_cnt = GUI_IMAGE_BE32(chunk) / 3;
+        }
+        else if (gui_memcmp(chunk + 4, "tRNS", 4) == 0) {
+            png->trns     = chunk + 8;
+            png->trns_len = GUI_IMAGE_BE32(chunk);
+        }
+    }
+
+    row  = png->window + window;
+    prev = row + stride;
+    gui_memset(prev, 0, stride);
+
+    result = GUI_E_OK;
+    if (type == 3 && png->plte == Co_NULL) {
+        result = GUI_E_ERROR;
+        i2 = 0;
+    }
+
+    for (i = 0; i < i2; i++) {
+        _gui_png_inflate(png, &filter, 1);
+        _gui_png_inflate(png, row, stride);
+
+        if (png->error || !_gui_png_unfilter(filter, row, prev, stride, bpp)) {
+            result = GUI_E_ERROR;
+            break;
+        }
+
+        /* rows over bound are inflated only */
+        if (i >= i1) {
+            for (j = j1; j < j2; j += n) {
+                n = MIN(j2 - j, GUI_IMAGE_CHUNK);
+                for (len = 0; len < (uint32_t)n; len++) {
+                    units[len] = _gui_png_pixel(png, row, j + len);
+                }
+                gui_image_put_pixels(dc, x + j, y + i, image, (uint8_t *)units, n);
+            }
+        }
+
+        tmp  = prev;
+        prev = row;
+        row  = tmp;
+    }
+
+    gui_free(png);
+
+    return result;
+}
@@ -0,0 +1,288 @@
+/**
+ ********************************************************************************
+ * @file       list.c
+ * @version    V0.7.4
+ * @date       2020.04.18
+ * @brief      List view widget management function.
+ *******************************************************************************
+ */
+
+#include <cogui.h>
+
+/**
+ *******************************************************************************
+ * @brief      Place row slots on current offset.
+ * @param[in]  *list    Which list view.
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Slot whose item changed is filled by render callback, others
+ *             are only moved. Slots after the last item are hidden.
+ *******************************************************************************
+ */
+static void _gui_list_view_layout(widget_t *list)
+{
+    list_view_t *data = list->user_data;
+    widget_t *row;
+    int32_t  first, index, width;
+    int16_t  i, slot;
+
+    first = data->offset / data->row_height;
+    width = GUI_RECT_WIDTH(&list->inner_extent);
+
+    for (i = 0; i < data->slot_cnt; i++) {
+        index = first + i;
+        slot  = index % data->slot_cnt;
+        row   = data->slots[slot];
+
+        if (index >= data->count) {
+            GUI_WIDGET_DISABLE(row);
+            data->slot_index[slot] = -1;
+            continue;
+        }
+
+        gui_widget_set_rectangle(row, 0, index * data->row_height - data->offset, width, data->row_height);
+
+        if (data->slot_index[slot] != index) {
+            data->slot_index[slot] = index;
+            data->render(list, row, index);
+        }
+
+        GUI_WIDGET_ENABLE(row);
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Create a list view widget.
+ * @param[in]  *top         Which window list view belongs to.
+ * @param[in]  *rect        Rectangle of list view.
+ * @param[in]  row_height   Height of every row.
+ * @param[in]  render       Callback to fill a row with content of an item.
+ * @param[out] None
+ * @retval     *list        The list view we create.
+ * @retval     Co_NULL      Out of memory.
+ *
+ * @par Description
+ * @details    List view is a scroll view holding just enough row slots to
+ *             cover its height. Items are not kept by list, render callback
+ *             is called when an item is scrolled onto a slot.
+ *******************************************************************************
+ */
+widget_t *gui_list_view_create(struct window *top, rect_t *rect, int32_t row_height, list_render_ptr render)
+{
+    widget_t *list, *row;
+    list_view_t *data;
+    int16_t  i, cnt;
+
+    ASSERT(rect != Co_NULL);
+    ASSERT(row_height > 0);
+    ASSERT(render != Co_NULL);
+
+    list = gui_container_create(top);
+    if (list == Co_NULL) {
+        return Co_NULL;
+    }
+
+    /* one more slot for the row cut on both edges */
+    cnt = (GUI_RECT_HEIGHT(rect) + row_height - 1) / row_height + 1;
+
+    /* slot tables are put after list data, freed together */
+    data = gui_malloc(sizeof(list_view_t) + cnt * (sizeof(widget_t *) + sizeof(int32_t)));
+    if (data == Co_NULL) {
+        gui_widget_delete(list);
+        return Co_NULL;
+    }
+    gui_memset(data, 0, sizeof(list_view_t));
+
+    data->row_height = row_height;
+    data->slot_cnt   = cnt;
+    data->slots      = (widget_t **)(data + 1);
+    data->slot_index = (int32_t *)(data->slots + cnt);
+    data->render     = render;
+
+    /* vertical offset is kept by list, it may be larger than 16 bits */
+    data->view.content_height = GUI_RECT_HEIGHT(rect);
+
+    list->user_data = data;
+    list->flag |= GUI_WIDGET_FLAG_RECT | GUI_WIDGET_FLAG_FILLED;
+    list->gc.foreground = white;
+    gui_widget_set_rectangle(list, rect->x1, rect->y1, GUI_RECT_WIDTH(rect), GUI_RECT_HEIGHT(rect));
+
+    for (i = 0; i < cnt; i++) {
+        row = gui_widget_create(top);
+        if (row == Co_NULL) {
+            gui_widget_delete(list);
+            return Co_NULL;
+        }
+
+        row->flag |= GUI_WIDGET_FLAG_RECT | GUI_WIDGET_FLAG_FILLED;
+        row->gc.foreground = white;
+        gui_widget_set_text_align(row, GUI_TEXT_ALIGN_LEFT|GUI_TEXT_ALIGN_MIDDLE);
+        gui_container_add_child(list, row);
+
+        data->slots[i]      = row;
+        data->slot_index[i] = -1;
+    }
+
+    return list;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Set how many items in list view.
+ * @param[in]  *list    Which list view.
+ * @param[in]  count    Item count.
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    All rows on screen are filled again and repainted.
+ *******************************************************************************
+ */
+void gui_list_view_set_count(widget_t *list, int32_t count)
+{
+    list_view_t *data;
+    int32_t max;
+    int16_t i;
+
+    ASSERT(list != Co_NULL);
+    data = list->user_data;
+
+    data->count = MAX(count, 0);
+
+    max = MAX(data->count * data->row_height - GUI_RECT_HEIGHT(&list->inner_extent), 0);
+    data->offset = MIN(data->offset, max);
+
+    for (i = 0; i < data->slot_cnt; i++) {
+        data->slot_index[i] = -1;
+    }
+
+    _gui_list_view_layout(list);
+    gui_widget_invalidate(list);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Fill an item again after its content changed.
+ * @param[in]  *list    Which list view.
+ * @param[in]  index    Which item.
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Nothing is done if item is not on screen, it is filled when
+ *             scrolled in.
+ *******************************************************************************
+ */
+void gui_list_view_update_item(widget_t *list, int32_t index)
+{
+    list_view_t *data;
+    int16_t slot;
+
+    ASSERT(list != Co_NULL);
+    data = list->user_data;
+
+    if (index < 0 || index >= data->count) {
+        return;
+    }
+
+    slot = index % data->slot_cnt;
+    if (data->slot_index[slot] != index) {
+        return;
+    }
+
+    data->render(list, data->slots[slot], index);
+    gui_widget_invalidate(data->slots[slot]);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Get item shown on a row slot.
+ * @param[in]  *list    Which list view.
+ * @param[in]  *row     Row slot, such as widget got by mouse event.
+ * @param[out] None
+ * @retval     index    Item on the row.
+ * @retval     -1       Widget is not a row of list.
+ *******************************************************************************
+ */
+int32_t gui_list_view_get_index(widget_t *list, widget_t *row)
+{
+    list_view_t *data;
+    int16_t i;
+
+    ASSERT(list != Co_NULL);
+    data = list->user_data;
+
+    for (i = 0; i < data->slot_cnt; i++) {
+        if (data->slots[i] == row) {
+            return data->slot_index[i];
+        }
+    }
+
+    return -1;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Scroll list view by pixels.
+ * @param[in]  *list    Which list view.
+ * @param[in]  dy       Pixels to scroll, positive to show later items.
+ * @param[out] None
+ * @retval     GUI_E_OK     List is scrolled.
+ * @retval     GUI_E_ERROR  Nothing is shown.
+ *
+ * @par Description
+ * @details    Rows on screen are moved by pixels, only rows scrolled in are
+ *             filled and painted.
+ *******************************************************************************
+ */
+StatusType gui_list_view_scroll(widget_t *list, int32_t dy)
+{
+    list_view_t *data;
+    int32_t offset, max;
+
+    ASSERT(list != Co_NULL);
+    data = list->user_data;
+
+    max = MAX(data->count * data->row_height - GUI_RECT_HEIGHT(&list->inner_extent), 0);
+    offset = MIN(MAX(data->offset + dy, 0), max);
+
+    dy = offset - data->offset;
+    if (dy == 0) {
+        return GUI_E_OK;
+    }
+
+    /* pixels are moved and rows laid out again in one frame */
+    gui_window_begin_update(list->top);
+
+    /* pixels on screen go the other way, rows damaged after this are
+     * already in new place */
+    gui_window_scroll(list->top, list, 0, -dy);
+
+    data->offset = offset;
+    _gui_list_view_layout(list);
+
+    return gui_window_end_update(list->top);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Scroll list view to show an item on top.
+ * @param[in]  *list    Which list view.
+ * @param[in]  index    Which item.
+ * @param[out] None
+ * @retval     GUI_E_OK     List is scrolled.
+ * @retval     GUI_E_ERROR  Nothing is shown.
+ *******************************************************************************
+ */
+StatusType gui_list_view_scroll_to(widget_t *list, int32_t index)
+{
+    list_view_t *data;
+
+    ASSERT(list != Co_NULL);
+    data = list->user_data;
+
+    return gui_list_view_scroll(list, index * data->row_height - data->offset);
+}
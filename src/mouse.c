@@ -10,8 +10,9 @@
 #include <cogui.h>
 
 cursor_t *_cursor=Co_NULL;
-extern window_t *main_page;
-bool_t first_show = 1;
+
+/* address of pixel (x, y) in current drawing buffer */
+#define GUI_CURSOR_PIXEL(d, x, y)     ((uint8_t *)((d)->frame_buffer + (y)*GUI_FB_PITCH(d)) + (x)*GUI_FB_BPP(d))
 
 void _gui_mouse_init()
 {
@@ -20,28 +21,174 @@ void _gui_mouse_init()
 
     gui_memset(_cursor, 0, sizeof(cursor_t));
 
-    _cursor->cursor_widget = gui_widget_create(main_page);
-	gui_widget_set_rectangle(_cursor->cursor_widget, 0, 0, 240, 320);
-    gui_widget_set_font(_cursor->cursor_widget, &tm_symbol_16x16);
-
-    _cursor->frame_buffer = ((struct dc_hw_t *)(_cursor->cursor_widget->dc_engine))->hw_driver->frame_buffer;
-
-    first_show = 1;
+    /* cursor picture is taken from symbol font, '#' is border and '$' is inner */
+    _cursor->border = &tm_symbol_16x16.data[('#' - 32) * GUI_CURSOR_SIZE];
+    _cursor->inner  = &tm_symbol_16x16.data[('$' - 32) * GUI_CURSOR_SIZE];
 
     gui_mouse_set_speed(GUI_MOUSE_SPEED_MIDDLE);
     gui_mouse_set_position(105, 155);
 }
 
-void gui_mouse_return_picture(void)
+/**
+ *******************************************************************************
+ * @brief      Get rectangle the cursor covers on screen
+ * @param[in]  None
+ * @param[out] *rect    Cursor rectangle, empty if cursor is hidden
+ * @retval     None
+ *******************************************************************************
+ */
+static void _gui_mouse_get_rect(rect_t *rect)
 {
-    GUI_CHECK_CURSOR();
-    uint16_t i, j;
+    graphic_driver_t *driver = gui_graphic_driver_get_default();
+
+    GUI_INIT_RECT(rect);
+
+    if (!_cursor->shown) {
+        return;
+    }
+
+    rect->x1 = _cursor->cx;
+    rect->y1 = _cursor->cy;
+    rect->x2 = MIN(_cursor->cx + GUI_CURSOR_SIZE, driver->width);
+    rect->y2 = MIN(_cursor->cy + GUI_CURSOR_SIZE, driver->height);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Show cursor change on screen
+ * @param[in]  None
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Cursor is composited in next frame by render task, or in an
+ *             empty frame right now if there is no render task.
+ *******************************************************************************
+ */
+static void _gui_mouse_update(void)
+{
+    graphic_driver_t *driver;
+    rect_t none;
+
+    if (gui_render_request() == GUI_E_OK) {
+        return;
+    }
+
+    driver = gui_graphic_driver_get_default();
+    GUI_INIT_RECT(&none);
+
+    /* a task painting its own frame must not see cursor come and go */
+    gui_render_lock();
+    gui_graphic_driver_begin_frame(driver);
+    gui_graphic_driver_end_frame(driver, &none);
+    gui_render_unlock();
+}
+
+/**
+ *******************************************************************************
+ * @brief      Take cursor away from drawing buffer
+ * @param[in]  None
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    This function is called before a frame is drawn, so widgets are
+ *             painted on the real screen content and never on the cursor.
+ *******************************************************************************
+ */
+void gui_mouse_overlay_remove(void)
+{
+    graphic_driver_t *driver = gui_graphic_driver_get_default();
+    rect_t *rect;
+    int16_t i, w;
 
-    for (i=0; i<16; i++) {
-        for (j=0; j<16; j++) {
-            gui_dc_draw_point(_cursor->cursor_widget->dc_engine, _cursor->cx+j, _cursor->cy+i, _cursor->save_picture[i][j]);
+    if (_cursor == Co_NULL || GUI_RECT_IS_EMPTY(&_cursor->drawn)) {
+        return;
+    }
+
+    rect = &_cursor->drawn;
+    w = GUI_RECT_WIDTH(rect) * GUI_FB_BPP(driver);
+
+    /* put saved pixels back */
+    for (i = 0; i < GUI_RECT_HEIGHT(rect); i++) {
+        gui_memcpy(GUI_CURSOR_PIXEL(driver, rect->x1, rect->y1 + i), _cursor->save_picture[i], w);
+    }
+
+    _cursor->removed = *rect;
+    GUI_INIT_RECT(&_cursor->drawn);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Composite cursor into drawing buffer
+ * @param[in]  *damage  Area changed in this frame
+ * @param[out] *damage  Old and new cursor area is added if cursor moved
+ * @retval     None
+ *
+ * @par Description
+ * @details    This function is called after a frame is drawn and before it is
+ *             shown. Pixels under cursor are saved first to remove it later.
+ *******************************************************************************
+ */
+void gui_mouse_overlay_draw(rect_t *damage)
+{
+    graphic_driver_t *driver = gui_graphic_driver_get_default();
+    rect_t rect;
+    uint8_t *dst, bpp;
+    uint16_t border, inner;
+    uint32_t pixel[2];
+    int16_t i, j, k, w;
+
+    ASSERT(damage != Co_NULL);
+
+    if (_cursor == Co_NULL) {
+        return;
+    }
+
+    _gui_mouse_get_rect(&rect);
+
+    /* cursor moved, both places are changed */
+    if (gui_memcmp(&rect, &_cursor->removed, sizeof(rect_t)) != 0) {
+        gui_rect_union(damage, &_cursor->removed, damage);
+        gui_rect_union(damage, &rect, damage);
+    }
+    GUI_INIT_RECT(&_cursor->removed);
+
+    if (GUI_RECT_IS_EMPTY(&rect)) {
+        return;
+    }
+
+    w   = GUI_RECT_WIDTH(&rect);
+    bpp = GUI_FB_BPP(driver);
+
+    /* inner and border color in format of drawing buffer */
+    pixel[0] = (bpp == 4) ? gui_color_to_argb8888(black) : (uint16_t)black;
+    pixel[1] = (bpp == 4) ? gui_color_to_argb8888(white) : (uint16_t)white;
+
+    for (i = 0; i < GUI_RECT_HEIGHT(&rect); i++) {
+        dst = GUI_CURSOR_PIXEL(driver, rect.x1, rect.y1 + i);
+        gui_memcpy(_cursor->save_picture[i], dst, w * bpp);
+
+        border = _cursor->border[i];
+        inner  = _cursor->inner[i];
+        for (j = 0; j < w; j++) {
+            if ((inner << j) & 0x8000) {
+                k = 0;
+            } else if ((border << j) & 0x8000) {
+                k = 1;
+            } else {
+                continue;
+            }
+
+            if (bpp == 4) {
+                ((uint32_t *)dst)[j] = pixel[k];
+            } else {
+                ((uint16_t *)dst)[j] = (uint16_t)pixel[k];
+            }
         }
     }
+
+    _cursor->drawn = rect;
 }
 
 void gui_mouse_set_position(uint16_t x, uint16_t y)
@@ -50,8 +197,9 @@ void gui_mouse_set_position(uint16_t x, uint16_t y)
 
     _cursor->cx = x;
     _cursor->cy = y;
-    
-    gui_mouse_show();
+    _cursor->shown = 1;
+
+    _gui_mouse_update();
 }
 
 void gui_mouse_set_speed(uint8_t speed)
@@ -76,10 +224,6 @@ void gui_mouse_move_to(uint16_t x,uint16_t y)
         return;
     }
 
-    if (!first_show) {
-        gui_mouse_return_picture();
-    }
-
     gui_mouse_set_position(x, y);
 }
 
@@ -106,37 +250,22 @@ void gui_mouse_get_position(point_t *pt)
     pt->y = _cursor->cy;
 }
 
-void gui_mouse_restore(void)
-{
-    GUI_CHECK_CURSOR();
-    uint32_t start_pt = _cursor->frame_buffer;
-    uint16_t i, j;
-    uint16_t buf;
-
-    for (i=0; i<16; i++) {
-        start_pt = _cursor->frame_buffer + 2*(240*(_cursor->cy+i) + _cursor->cx);
-        for (j=0; j<16; j++) {
-            buf = *(uint16_t *)start_pt;
-            _cursor->save_picture[i][j] = buf;
-            start_pt += 2;
-        }
-    }
-    first_show = 0;
-}
-
 void gui_mouse_show(void)
 {     
-    if (_cursor == Co_NULL) {
+    if (_cursor == Co_NULL || _cursor->shown) {
         return;
     }  
 
-    gui_mouse_restore();
+    _cursor->shown = 1;
+    _gui_mouse_update();
+}
 
-    rect_t rect;
-    GUI_SET_RECT(&rect, _cursor->cx, _cursor->cy, 16, 16);
+void gui_mouse_hide(void)
+{
+    if (_cursor == Co_NULL || !_cursor->shown) {
+        return;
+    }
 
-	_cursor->cursor_widget->gc.foreground = white;
-    gui_dc_draw_text(_cursor->cursor_widget->dc_engine, &rect, "#");
-	_cursor->cursor_widget->gc.foreground = black;
-    gui_dc_draw_text(_cursor->cursor_widget->dc_engine, &rect, "$");
+    _cursor->shown = 0;
+    _gui_mouse_update();
 }
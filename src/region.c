@@ -0,0 +1,274 @@
+/**
+ *******************************************************************************
+ * @file       region.c
+ * @version    V0.7.4
+ * @date       2020.04.18
+ * @brief      Rectangle and region function for GUI engine.
+ *******************************************************************************
+ */
+
+#include <cogui.h>
+
+/**
+ *******************************************************************************
+ * @brief      Get intersection of two rectangles.
+ * @param[in]  *r1          First rectangle.
+ * @param[in]  *r2          Second rectangle.
+ * @param[out] *result      Intersection of two rectangles.
+ * @retval     1            Two rectangles are intersected.
+ * @retval     0            Result is empty.
+ *******************************************************************************
+ */
+bool_t gui_rect_intersect(const rect_t *r1, const rect_t *r2, rect_t *result)
+{
+    ASSERT(r1 != Co_NULL && r2 != Co_NULL && result != Co_NULL);
+
+    result->x1 = MAX(r1->x1, r2->x1);
+    result->x2 = MIN(r1->x2, r2->x2);
+    result->y1 = MAX(r1->y1, r2->y1);
+    result->y2 = MIN(r1->y2, r2->y2);
+
+    return !GUI_RECT_IS_EMPTY(result);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Get bounding rectangle of two rectangles.
+ * @param[in]  *r1          First rectangle.
+ * @param[in]  *r2          Second rectangle.
+ * @param[out] *result      Bounding rectangle, empty one is ignored.
+ * @retval     None
+ *******************************************************************************
+ */
+void gui_rect_union(const rect_t *r1, const rect_t *r2, rect_t *result)
+{
+    ASSERT(r1 != Co_NULL && r2 != Co_NULL && result != Co_NULL);
+
+    if (GUI_RECT_IS_EMPTY(r1)) {
+        *result = *r2;
+        return;
+    }
+
+    if (GUI_RECT_IS_EMPTY(r2)) {
+        *result = *r1;
+        return;
+    }
+
+    result->x1 = MIN(r1->x1, r2->x1);
+    result->x2 = MAX(r1->x2, r2->x2);
+    result->y1 = MIN(r1->y1, r2->y1);
+    result->y2 = MAX(r1->y2, r2->y2);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Determine whether two rectangles are intersected.
+ * @param[in]  *r1          First rectangle.
+ * @param[in]  *r2          Second rectangle.
+ * @param[out] None
+ * @retval     1            Two rectangles are intersected.
+ * @retval     0            Two rectangles are not intersected.
+ *******************************************************************************
+ */
+bool_t gui_rect_is_intersect(const rect_t *r1, const rect_t *r2)
+{
+    return (r1->x1 < r2->x2 && r2->x1 < r1->x2 &&
+            r1->y1 < r2->y2 && r2->y1 < r1->y2);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Initial a region to one rectangle.
+ * @param[in]  *region      Region to initial.
+ * @param[in]  *rect        First rectangle of region.
+ * @param[out] None
+ * @retval     None
+ *******************************************************************************
+ */
+void gui_region_init(region_t *region, const rect_t *rect)
+{
+    ASSERT(region != Co_NULL);
+
+    region->count = 0;
+
+    if (rect != Co_NULL && !GUI_RECT_IS_EMPTY(rect)) {
+        region->rects[region->count++] = *rect;
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Add a rectangle to region.
+ * @param[in]  *region      Region to grow.
+ * @param[in]  *rect        Rectangle to add.
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Rectangles overlapping the new one, or lining up with it so
+ *             their bounding rectangle wastes nothing, are merged with it,
+ *             so rectangles of region stay apart. If region is full, the new
+ *             one is merged with the rectangle whose bounding box grows
+ *             least. Region may be larger than exact union but never smaller.
+ *******************************************************************************
+ */
+void gui_region_add_rect(region_t *region, const rect_t *rect)
+{
+    rect_t   r, u;
+    int16_t  i, best;
+    uint32_t cost, best_cost;
+
+    ASSERT(region != Co_NULL);
+    ASSERT(rect != Co_NULL);
+
+    if (GUI_RECT_IS_EMPTY(rect)) {
+        return;
+    }
+
+    r = *rect;
+
+    for (;;) {
+        /* merged rectangle may reach ones checked before, so start over */
+        for (i = 0; i < region->count; ) {
+            gui_rect_union(&region->rects[i], &r, &u);
+
+            if (gui_rect_is_intersect(&region->rects[i], &r) ||
+                GUI_RECT_AREA(&u) == GUI_RECT_AREA(&region->rects[i]) + GUI_RECT_AREA(&r)) {
+                r = u;
+                region->rects[i] = region->rects[--region->count];
+                i = 0;
+                continue;
+            }
+            i++;
+        }
+
+        if (region->count < COGUI_REGION_MAX_RECTS) {
+            break;
+        }
+
+        /* no room, take in the neighbour it costs least to cover */
+        best      = 0;
+        best_cost = 0xFFFFFFFF;
+        for (i = 0; i < region->count; i++) {
+            gui_rect_union(&region->rects[i], &r, &u);
+            cost = GUI_RECT_AREA(&u) - GUI_RECT_AREA(&region->rects[i]);
+            if (cost < best_cost) {
+                best_cost = cost;
+                best      = i;
+            }
+        }
+
+        gui_rect_union(&region->rects[best], &r, &r);
+        region->rects[best] = region->rects[--region->count];
+    }
+
+    region->rects[region->count++] = r;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Cut a rectangle out of another one.
+ * @param[in]  *r           Rectangle to cut.
+ * @param[in]  *rect        Rectangle to remove, must intersect r.
+ * @param[out] piece        Pieces of r left, over, under, left and right.
+ * @retval     n            How many pieces, 0 if r is fully covered.
+ *******************************************************************************
+ */
+int16_t gui_rect_subtract(const rect_t *r, const rect_t *rect, rect_t piece[4])
+{
+    int16_t n = 0;
+
+    if (r->y1 < rect->y1) {
+        GUI_SET_RECT(&piece[n], r->x1, r->y1, r->x2 - r->x1, rect->y1 - r->y1);
+        n++;
+    }
+    if (rect->y2 < r->y2) {
+        GUI_SET_RECT(&piece[n], r->x1, rect->y2, r->x2 - r->x1, r->y2 - rect->y2);
+        n++;
+    }
+    if (r->x1 < rect->x1) {
+        piece[n].x1 = r->x1;
+        piece[n].x2 = rect->x1;
+        piece[n].y1 = MAX(r->y1, rect->y1);
+        piece[n].y2 = MIN(r->y2, rect->y2);
+        n++;
+    }
+    if (rect->x2 < r->x2) {
+        piece[n].x1 = rect->x2;
+        piece[n].x2 = r->x2;
+        piece[n].y1 = MAX(r->y1, rect->y1);
+        piece[n].y2 = MIN(r->y2, rect->y2);
+        n++;
+    }
+
+    return n;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Remove a rectangle from region.
+ * @param[in]  *region      Region to cut.
+ * @param[in]  *rect        Rectangle to remove.
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Every rectangle of region intersected with rect is split into
+ *             up to four pieces around it. If region has no room for the
+ *             pieces, the original rectangle is kept, so the region may be
+ *             larger than exact result but never smaller.
+ *******************************************************************************
+ */
+void gui_region_subtract_rect(region_t *region, const rect_t *rect)
+{
+    int16_t i, n;
+    rect_t  r, piece[4];
+
+    ASSERT(region != Co_NULL);
+    ASSERT(rect != Co_NULL);
+
+    for (i = 0; i < region->count; ) {
+        r = region->rects[i];
+
+        if (!gui_rect_is_intersect(&r, rect)) {
+            i++;
+            continue;
+        }
+
+        /* pieces over, under, left and right of the cut rectangle */
+        n = gui_rect_subtract(&r, rect, piece);
+
+        if (n == 0) {
+            /* fully covered, replace it with the last one */
+            region->rects[i] = region->rects[--region->count];
+            continue;
+        }
+
+        if (region->count + n - 1 > COGUI_REGION_MAX_RECTS) {
+            i++;        /* no room to split, keep it as it is                 */
+            continue;
+        }
+
+        /* first piece takes the old slot, others are put on the end */
+        region->rects[i++] = piece[0];
+        while (--n) {
+            region->rects[region->count++] = piece[n];
+        }
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Determine whether a region is empty.
+ * @param[in]  *region      Region to check.
+ * @param[out] None
+ * @retval     1            Region has no pixel inside.
+ * @retval     0            Region is not empty.
+ *******************************************************************************
+ */
+bool_t gui_region_is_empty(region_t *region)
+{
+    ASSERT(region != Co_NULL);
+
+    return region->count == 0;
+}
@@ -0,0 +1,194 @@
+/**
+ *******************************************************************************
+ * @file       render.c
+ * @version    V0.7.4
+ * @date       2020.04.18
+ * @brief      The frame scheduler for gui engine.
+ *******************************************************************************
+ */
+
+#include <cogui.h>
+
+#define GUI_RENDER_NO_OWNER     0xFF            /**< lock is not held by any task */
+
+#if COGUI_FRAME_RATE > 0
+/* ticks between two frames */
+#define GUI_RENDER_FRAME_TICKS  (CFG_SYSTICK_FREQ / COGUI_FRAME_RATE)
+
+OS_STK   render_Stk[512]={0};
+static bool_t     vsync_enabled = 0;
+#endif
+
+static bool_t     render_running = 0;
+static OS_FlagID  frame_flag;
+static OS_FlagID  vsync_flag;
+
+static bool_t     lock_ready = 0;
+static OS_MutexID render_mutex;
+static OS_TID     lock_owner = GUI_RENDER_NO_OWNER;
+static uint16_t   lock_depth = 0;
+
+#if COGUI_FRAME_RATE > 0
+/**
+ *******************************************************************************
+ * @brief      Wait for the moment to paint next frame
+ * @param[in]  next     Time (tick) of next frame
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Frames are not painted faster than COGUI_FRAME_RATE. If panel
+ *             driver gives vsync signal, painting also starts right after it,
+ *             so nothing is changed while panel is reading the frame. A frame
+ *             is painted anyway if no vsync comes in one frame time.
+ *******************************************************************************
+ */
+static void _gui_render_wait_frame(uint64_t next)
+{
+    uint64_t now = CoGetOSTime();
+
+    if (now < next) {
+        CoTickDelay((U32)(next - now));
+    }
+
+    if (vsync_enabled) {
+        CoClearFlag(vsync_flag);
+        CoWaitForSingleFlag(vsync_flag, GUI_RENDER_FRAME_TICKS);
+    }
+}
+
+void gui_render_entry(void *parameter)
+{
+    graphic_driver_t *driver = gui_graphic_driver_get_default();
+    uint64_t next = CoGetOSTime();
+    rect_t painted;
+
+    for (;;) {
+        /* sleep until something is damaged */
+        CoWaitForSingleFlag(frame_flag, 0);
+
+        _gui_render_wait_frame(next);
+        next = CoGetOSTime() + GUI_RENDER_FRAME_TICKS;
+
+        gui_render_lock();
+        GUI_INIT_RECT(&painted);
+        gui_graphic_driver_begin_frame(driver);
+
+        /* damaged area is recorded on windows on screen */
+        gui_window_flush_all(&painted);
+
+        /* flip finished frame to panel if double buffered */
+        gui_graphic_driver_end_frame(driver, &painted);
+        gui_render_unlock();
+    }
+}
+#endif /* COGUI_FRAME_RATE > 0 */
+
+/**
+ *******************************************************************************
+ * @brief      Request painting of next frame
+ * @param[in]  None
+ * @param[out] None
+ * @retval     GUI_E_OK     Next frame will be painted by render task
+ * @retval     GUI_E_ERROR  No render task, caller should paint by itself
+ *******************************************************************************
+ */
+StatusType gui_render_request(void)
+{
+    if (!render_running) {
+        return GUI_E_ERROR;
+    }
+
+    CoSetFlag(frame_flag);
+
+    return GUI_E_OK;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Vsync (TE) signal from panel
+ * @param[in]  None
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    This function is given to panel driver and called in interrupt.
+ *******************************************************************************
+ */
+void gui_render_vsync(void)
+{
+    if (render_running) {
+        isr_SetFlag(vsync_flag);
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Lock widgets from render task
+ * @param[in]  None
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Lock can be nested in the same task, so update transactions of
+ *             different windows can be opened together. Without render task
+ *             it still keeps tasks that paint by themselves apart.
+ *******************************************************************************
+ */
+void gui_render_lock(void)
+{
+    OS_TID tid;
+
+    if (!lock_ready) {
+        return;
+    }
+
+    tid = CoGetCurTaskID();
+    if (lock_owner == tid) {
+        lock_depth++;
+        return;
+    }
+
+    CoEnterMutexSection(render_mutex);
+    lock_owner = tid;
+    lock_depth = 1;
+}
+
+void gui_render_unlock(void)
+{
+    if (!lock_ready) {
+        return;
+    }
+
+    ASSERT(lock_owner == CoGetCurTaskID());
+
+    if (--lock_depth == 0) {
+        lock_owner = GUI_RENDER_NO_OWNER;
+        CoLeaveMutexSection(render_mutex);
+    }
+}
+
+void gui_render_init(void)
+{
+#if COGUI_FRAME_RATE > 0
+    graphic_driver_t *driver = gui_graphic_driver_get_default();
+#endif
+
+    /* tasks painting by themselves are kept apart too */
+    render_mutex = CoCreateMutex();
+    lock_ready   = 1;
+
+#if COGUI_FRAME_RATE > 0
+    frame_flag   = CoCreateFlag(Co_TRUE, Co_FALSE);
+    vsync_flag   = CoCreateFlag(Co_TRUE, Co_FALSE);
+
+    /* pace frames with panel if it can tell us */
+    if (driver->panel_ops != Co_NULL && driver->panel_ops->set_vsync_handler != Co_NULL) {
+        driver->panel_ops->set_vsync_handler(gui_render_vsync);
+        vsync_enabled = 1;
+    }
+
+    render_running = 1;
+    CoCreateTask(gui_render_entry, (void *)0, 16, &render_Stk[511], 512);
+#endif
+}
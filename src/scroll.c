@@ -0,0 +1,157 @@
+/**
+ ********************************************************************************
+ * @file       scroll.c
+ * @version    V0.7.4
+ * @date       2020.04.18
+ * @brief      Scroll view widget management function.
+ *******************************************************************************
+ */
+
+#include <cogui.h>
+
+/**
+ *******************************************************************************
+ * @brief      Create a scroll view widget.
+ * @param[in]  *top     Which window scroll view belongs to.
+ * @param[out] None
+ * @retval     *view    The scroll view we create.
+ * @retval     Co_NULL  Out of memory.
+ *
+ * @par Description
+ * @details    Scroll view is a filled container whose children are moved by
+ *             its content offset. Scrolling moves pixels already on screen,
+ *             so only the part newly scrolled in is painted.
+ *******************************************************************************
+ */
+widget_t *gui_scroll_view_create(struct window *top)
+{
+    widget_t *view = gui_container_create(top);
+    if (view == Co_NULL) {
+        return Co_NULL;
+    }
+
+    view->user_data = gui_malloc(sizeof(scroll_view_t));
+    if (view->user_data == Co_NULL) {
+        gui_widget_delete(view);
+        return Co_NULL;
+    }
+    gui_memset(view->user_data, 0, sizeof(scroll_view_t));
+
+    /* opaque, so its pixels can be moved without its container */
+    view->flag |= GUI_WIDGET_FLAG_RECT | GUI_WIDGET_FLAG_FILLED;
+    view->gc.foreground = white;
+
+    return view;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Set size of content inside scroll view.
+ * @param[in]  *view    Which scroll view.
+ * @param[in]  width    Content width, 0 for no limit.
+ * @param[in]  height   Content height, 0 for no limit.
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Content offset is kept inside content size after this call.
+ *******************************************************************************
+ */
+void gui_scroll_view_set_content_size(widget_t *view, int32_t width, int32_t height)
+{
+    scroll_view_t *data;
+
+    ASSERT(view != Co_NULL);
+    data = view->user_data;
+
+    data->content_width  = width;
+    data->content_height = height;
+
+    gui_scroll_view_scroll(view, 0, 0);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Scroll content of scroll view by distance.
+ * @param[in]  *view    Which scroll view.
+ * @param[in]  dx       Distance content offset moves on x axis.
+ * @param[in]  dy       Distance content offset moves on y axis.
+ * @param[out] None
+ * @retval     GUI_E_OK     Content is scrolled.
+ * @retval     GUI_E_ERROR  Nothing is shown.
+ *
+ * @par Description
+ * @details    Positive distance shows content further right and down, so
+ *             pixels on screen move left and up.
+ *******************************************************************************
+ */
+StatusType gui_scroll_view_scroll(widget_t *view, int32_t dx, int32_t dy)
+{
+    scroll_view_t *data;
+    int32_t x, y, max;
+
+    ASSERT(view != Co_NULL);
+    data = view->user_data;
+
+    /* offset and pixel move are seen by render task in one frame */
+    gui_window_begin_update(view->top);
+
+    x = view->scroll.x + dx;
+    y = view->scroll.y + dy;
+
+    /* keep offset inside content */
+    if (data->content_width > 0) {
+        max = MAX(data->content_width - GUI_RECT_WIDTH(&view->inner_extent), 0);
+        x = MIN(MAX(x, 0), max);
+    }
+    if (data->content_height > 0) {
+        max = MAX(data->content_height - GUI_RECT_HEIGHT(&view->inner_extent), 0);
+        y = MIN(MAX(y, 0), max);
+    }
+
+    dx = x - view->scroll.x;
+    dy = y - view->scroll.y;
+    if (dx != 0 || dy != 0) {
+        /* pixels on screen go the other way */
+        gui_window_scroll(view->top, view, -dx, -dy);
+
+        view->scroll.x = x;
+        view->scroll.y = y;
+    }
+
+    return gui_window_end_update(view->top);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Scroll content of scroll view to an offset.
+ * @param[in]  *view    Which scroll view.
+ * @param[in]  x        Content offset on x axis.
+ * @param[in]  y        Content offset on y axis.
+ * @param[out] None
+ * @retval     GUI_E_OK     Content is scrolled.
+ * @retval     GUI_E_ERROR  Nothing is shown.
+ *******************************************************************************
+ */
+StatusType gui_scroll_view_scroll_to(widget_t *view, int32_t x, int32_t y)
+{
+    ASSERT(view != Co_NULL);
+
+    return gui_scroll_view_scroll(view, x - view->scroll.x, y - view->scroll.y);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Get content offset of scroll view.
+ * @param[in]  *view    Which scroll view.
+ * @param[out] *offset  Content offset.
+ * @retval     None
+ *******************************************************************************
+ */
+void gui_scroll_view_get_offset(widget_t *view, point_t *offset)
+{
+    ASSERT(view != Co_NULL);
+    ASSERT(offset != Co_NULL);
+
+    *offset = view->scroll;
+}
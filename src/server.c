@@ -16,7 +16,6 @@ extern struct main_app_table main_app_table[9];
 
 void gui_server_handler_mouse_button(event_t *event)
 {
-    gui_mouse_return_picture();
     if (gui_get_current_window() == gui_get_main_window()) {
         point_t cursor_pt;
         widget_t *event_wgt, *last_ewgt = main_page->last_mouse_event_widget;
@@ -129,22 +128,22 @@ StatusType gui_server_event_handler(event_t *event)
 
     case EVENT_WINDOW_CLOSE:
     {
-        if (event->win) {
-            result = GUI_E_ERROR;
+        /* other windows stay on top, main page comes back only on empty screen */
+        result = GUI_E_OK;
+        if (gui_get_current_window() == Co_NULL) {
+            result = gui_window_show(server_app->win);
         }
-
-        result = gui_window_show(server_app->win);    
         gui_mouse_show();
         break;
     }
 
     case EVENT_WINDOW_HIDE:
     {
-        if (GUI_WINDOW_IS_ENABLE(event->win)) {
-            result = GUI_E_ERROR;
+        /* other windows stay on top, main page comes back only on empty screen */
+        result = GUI_E_OK;
+        if (gui_get_current_window() == Co_NULL) {
+            result = gui_window_show(server_app->win);
         }
-
-        result = gui_window_show(server_app->win);    
         gui_mouse_show();
         break;
     }
@@ -20,5 +20,9 @@ font_t tm_symbol_16x16 = {
     "tm",
 	16,
 	16,
-	tm_symbol16x16
+	tm_symbol16x16,
+	Co_NULL,
+	Co_NULL,
+	0,
+	Co_NULL
 };
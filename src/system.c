@@ -20,6 +20,7 @@
  */
 void gui_system_init(void)
 {
+    gui_render_init();
     gui_server_init();
 }
 
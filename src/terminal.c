@@ -0,0 +1,569 @@
+/**
+ ********************************************************************************
+ * @file       terminal.c
+ * @version    V0.7.4
+ * @date       2020.04.18
+ * @brief      Character cell terminal widget management function.
+ *******************************************************************************
+ */
+
+#include <cogui.h>
+
+/* escape sequence parser state */
+#define GUI_TERM_STATE_NORMAL       0
+#define GUI_TERM_STATE_ESC          1
+#define GUI_TERM_STATE_CSI          2
+
+#define GUI_TERM_ESC                0x1B
+#define GUI_TERM_TAB_SIZE           8
+
+static void _gui_terminal_draw(widget_t *widget, rect_t *clip);
+
+/**
+ *******************************************************************************
+ * @brief      Get colour of attribute index.
+ * @param[in]  index    Colour index of cell attribute.
+ * @param[out] None
+ * @retval     color    Colour to paint.
+ *******************************************************************************
+ */
+static color_t _gui_terminal_color(uint8_t index)
+{
+    switch (index) {
+        case GUI_TERM_RED:      return red;
+        case GUI_TERM_GREEN:    return green;
+        case GUI_TERM_YELLOW:   return yellow;
+        case GUI_TERM_BLUE:     return blue;
+        case GUI_TERM_MAGENTA:  return purple;
+        case GUI_TERM_CYAN:     return cyan;
+        case GUI_TERM_WHITE:    return white;
+        case GUI_TERM_BLACK:
+        default:                return black;
+    }
+}
+
+static uint16_t *_gui_terminal_line(terminal_t *term, int16_t row)
+{
+    return term->cells + ((term->head + row) % term->rows) * term->cols;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Mark cells of a screen row changed.
+ * @param[in]  *term    Which terminal.
+ * @param[in]  row      Screen row.
+ * @param[in]  x1       First column changed.
+ * @param[in]  x2       Column after the last one changed.
+ * @param[out] None
+ * @retval     None
+ *******************************************************************************
+ */
+static void _gui_terminal_touch(terminal_t *term, int16_t row, int16_t x1, int16_t x2)
+{
+    int16_t *dirty = term->dirty + ((term->head + row) % term->rows) * 2;
+
+    if (dirty[0] >= dirty[1]) {
+        dirty[0] = x1;
+        dirty[1] = x2;
+    }
+    else {
+        dirty[0] = MIN(dirty[0], x1);
+        dirty[1] = MAX(dirty[1], x2);
+    }
+}
+
+static void _gui_terminal_erase(terminal_t *term, int16_t row, int16_t x1, int16_t x2)
+{
+    uint16_t *line = _gui_terminal_line(term, row);
+    int16_t  x;
+
+    x1 = MAX(x1, 0);
+    x2 = MIN(x2, term->cols);
+
+    for (x = x1; x < x2; x++) {
+        line[x] = GUI_TERM_CELL(' ', term->attr);
+    }
+
+    if (x1 < x2) {
+        _gui_terminal_touch(term, row, x1, x2);
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Move cursor to next line.
+ * @param[in]  *term    Which terminal.
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    On the last row, screen is scrolled up by moving ring head, and
+ *             the line coming out of the ring is cleared for the new row.
+ *******************************************************************************
+ */
+static void _gui_terminal_linefeed(terminal_t *term)
+{
+    if (term->cy < term->rows - 1) {
+        term->cy++;
+        return;
+    }
+
+    term->head = (term->head + 1) % term->rows;
+    if (term->scrolled < term->rows) {
+        term->scrolled++;
+    }
+
+    _gui_terminal_erase(term, term->rows - 1, 0, term->cols);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Change attribute by select graphic rendition sequence.
+ * @param[in]  *term    Which terminal.
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Reset, reverse video, foreground and background colours are
+ *             supported, other numbers are ignored.
+ *******************************************************************************
+ */
+static void _gui_terminal_sgr(terminal_t *term)
+{
+    int16_t i, n;
+    uint8_t fg, bg;
+
+    for (i = 0; i < MIN(MAX(term->nparams, 1), GUI_TERM_MAX_PARAMS); i++) {
+        n  = term->params[i];
+        fg = GUI_TERM_ATTR_FG(term->attr);
+        bg = GUI_TERM_ATTR_BG(term->attr);
+
+        if (n == 0) {
+            term->attr = GUI_TERM_ATTR_DEFAULT;
+        }
+        else if (n == 7) {
+            term->attr = GUI_TERM_ATTR(bg, fg);
+        }
+        else if (n >= 30 && n <= 37) {
+            term->attr = GUI_TERM_ATTR(n - 30, bg);
+        }
+        else if (n == 39) {
+            term->attr = GUI_TERM_ATTR(GUI_TERM_ATTR_FG(GUI_TERM_ATTR_DEFAULT), bg);
+        }
+        else if (n >= 40 && n <= 47) {
+            term->attr = GUI_TERM_ATTR(fg, n - 40);
+        }
+        else if (n == 49) {
+            term->attr = GUI_TERM_ATTR(fg, GUI_TERM_ATTR_BG(GUI_TERM_ATTR_DEFAULT));
+        }
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Run a control sequence.
+ * @param[in]  *term    Which terminal.
+ * @param[in]  c        Final character of sequence.
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Cursor movement (A B C D H f), erase in display (J), erase in
+ *             line (K) and graphic rendition (m) are supported.
+ *******************************************************************************
+ */
+static void _gui_terminal_csi(terminal_t *term, char c)
+{
+    int16_t n = MAX(term->params[0], 1);
+    int16_t row;
+
+    switch (c) {
+        case 'A':
+            term->cy = MAX(term->cy - n, 0);
+            break;
+
+        case 'B':
+            term->cy = MIN(term->cy + n, term->rows - 1);
+            break;
+
+        case 'C':
+            term->cx = MIN(term->cx + n, term->cols - 1);
+            break;
+
+        case 'D':
+            term->cx = MAX(MIN(term->cx, term->cols - 1) - n, 0);
+            break;
+
+        case 'H':
+        case 'f':
+            /* position counts from 1 */
+            term->cy = MIN(MAX(term->params[0], 1), term->rows) - 1;
+            term->cx = MIN(MAX(term->params[1], 1), term->cols) - 1;
+            break;
+
+        case 'J':
+            if (term->params[0] == 0) {
+                _gui_terminal_erase(term, term->cy, term->cx, term->cols);
+                for (row = term->cy + 1; row < term->rows; row++) {
+                    _gui_terminal_erase(term, row, 0, term->cols);
+                }
+            }
+            else if (term->params[0] == 1) {
+                for (row = 0; row < term->cy; row++) {
+                    _gui_terminal_erase(term, row, 0, term->cols);
+                }
+                _gui_terminal_erase(term, term->cy, 0, term->cx + 1);
+            }
+            else if (term->params[0] == 2) {
+                for (row = 0; row < term->rows; row++) {
+                    _gui_terminal_erase(term, row, 0, term->cols);
+                }
+            }
+            break;
+
+        case 'K':
+            if (term->params[0] == 0) {
+                _gui_terminal_erase(term, term->cy, term->cx, term->cols);
+            }
+            else if (term->params[0] == 1) {
+                _gui_terminal_erase(term, term->cy, 0, term->cx + 1);
+            }
+            else if (term->params[0] == 2) {
+                _gui_terminal_erase(term, term->cy, 0, term->cols);
+            }
+            break;
+
+        case 'm':
+            _gui_terminal_sgr(term);
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Put one character into terminal.
+ * @param[in]  *term    Which terminal.
+ * @param[in]  c        Character or part of escape sequence.
+ * @param[out] None
+ * @retval     None
+ *******************************************************************************
+ */
+static void _gui_terminal_putc(terminal_t *term, char c)
+{
+    uint16_t *line;
+
+    if (term->state == GUI_TERM_STATE_ESC) {
+        term->state = GUI_TERM_STATE_NORMAL;
+
+        if (c == '[') {
+            gui_memset(term->params, 0, sizeof(term->params));
+            term->nparams = 0;
+            term->state   = GUI_TERM_STATE_CSI;
+        }
+        return;
+    }
+
+    if (term->state == GUI_TERM_STATE_CSI) {
+        if (c >= '0' && c <= '9') {
+            if (term->nparams == 0) {
+                term->nparams = 1;
+            }
+            if (term->nparams <= GUI_TERM_MAX_PARAMS) {
+                term->params[term->nparams - 1] = term->params[term->nparams - 1] * 10 + (c - '0');
+            }
+        }
+        else if (c == ';') {
+            /* extra parameters are dropped, count stops past the last */
+            term->nparams = MIN(MAX(term->nparams, 1) + 1, GUI_TERM_MAX_PARAMS + 1);
+        }
+        else {
+            term->state = GUI_TERM_STATE_NORMAL;
+            _gui_terminal_csi(term, c);
+        }
+        return;
+    }
+
+    switch (c) {
+        case GUI_TERM_ESC:
+            term->state = GUI_TERM_STATE_ESC;
+            break;
+
+        case '\r':
+            term->cx = 0;
+            break;
+
+        /* new line goes back to first column too, like gui_lcd_puts */
+        case '\n':
+            term->cx = 0;
+            _gui_terminal_linefeed(term);
+            break;
+
+        case '\b':
+            term->cx = MAX(MIN(term->cx, term->cols - 1) - 1, 0);
+            break;
+
+        case '\t':
+            term->cx = MIN((term->cx / GUI_TERM_TAB_SIZE + 1) * GUI_TERM_TAB_SIZE, term->cols - 1);
+            break;
+
+        default:
+            /* only characters in font table */
+            if (c < ' ' || c > '~') {
+                break;
+            }
+
+            /* cursor stays after last column until next character comes */
+            if (term->cx >= term->cols) {
+                term->cx = 0;
+                _gui_terminal_linefeed(term);
+            }
+
+            line = _gui_terminal_line(term, term->cy);
+            if (line[term->cx] != GUI_TERM_CELL(c, term->attr)) {
+                line[term->cx] = GUI_TERM_CELL(c, term->attr);
+                _gui_terminal_touch(term, term->cy, term->cx, term->cx + 1);
+            }
+            term->cx++;
+            break;
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Hand changed cells over for painting.
+ * @param[in]  *widget  Terminal widget.
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Scrolled lines move pixels already on screen, then the columns
+ *             changed on each row are marked damaged.
+ *******************************************************************************
+ */
+static void _gui_terminal_commit(widget_t *widget)
+{
+    terminal_t *term = widget->user_data;
+    int16_t  row, *dirty;
+    rect_t   rect, bound;
+    bool_t   shown;
+
+    gui_window_begin_update(widget->top);
+
+    if (term->scrolled > 0) {
+        gui_window_scroll(widget->top, widget, 0, -term->scrolled * term->font->height);
+        term->scrolled = 0;
+    }
+
+    gui_widget_update_extent(widget);
+    shown = gui_widget_get_clip_extent(widget, &bound);
+
+    /* each row's span is damaged on its own, rows between are not repainted */
+    for (row = 0; row < term->rows; row++) {
+        dirty = term->dirty + ((term->head + row) % term->rows) * 2;
+        if (dirty[0] >= dirty[1]) {
+            continue;
+        }
+
+        rect.x1 = widget->extent.x1 + dirty[0] * term->font->width;
+        rect.x2 = widget->extent.x1 + dirty[1] * term->font->width;
+        rect.y1 = widget->extent.y1 + row * term->font->height;
+        rect.y2 = rect.y1 + term->font->height;
+        if (shown && gui_rect_intersect(&rect, &bound, &rect)) {
+            gui_window_invalidate(widget->top, &rect);
+        }
+
+        dirty[0] = dirty[1] = 0;
+    }
+
+    gui_window_end_update(widget->top);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Create a terminal widget.
+ * @param[in]  *top     Which window terminal belongs to.
+ * @param[in]  *rect    Rectangle of terminal.
+ * @param[in]  *font    Fixed width font of cells.
+ * @param[out] None
+ * @retval     *widget  The terminal we create.
+ * @retval     Co_NULL  Out of memory.
+ *
+ * @par Description
+ * @details    Terminal keeps a grid of cells as big as rectangle can hold.
+ *             Text written is parsed for a subset of VT100 sequences, and
+ *             only the cells changed are painted again.
+ *******************************************************************************
+ */
+widget_t *gui_terminal_create(struct window *top, rect_t *rect, font_t *font)
+{
+    widget_t *widget;
+    terminal_t *term;
+    int16_t  cols, rows;
+    int32_t  i;
+
+    ASSERT(rect != Co_NULL);
+    ASSERT(font != Co_NULL);
+    ASSERT(GUI_FONT_IS_MONO(font));
+
+    cols = GUI_RECT_WIDTH(rect) / font->width;
+    rows = GUI_RECT_HEIGHT(rect) / font->height;
+    if (cols <= 0 || rows <= 0) {
+        return Co_NULL;
+    }
+
+    widget = gui_widget_create(top);
+    if (widget == Co_NULL) {
+        return Co_NULL;
+    }
+
+    /* cells and dirty columns are put after terminal data, freed together */
+    term = gui_malloc(sizeof(terminal_t) + rows * cols * sizeof(uint16_t) + rows * 2 * sizeof(int16_t));
+    if (term == Co_NULL) {
+        gui_widget_delete(widget);
+        return Co_NULL;
+    }
+    gui_memset(term, 0, sizeof(terminal_t));
+
+    term->font  = font;
+    term->cols  = cols;
+    term->rows  = rows;
+    term->attr  = GUI_TERM_ATTR_DEFAULT;
+    term->cells = (uint16_t *)(term + 1);
+    term->dirty = (int16_t *)(term->cells + rows * cols);
+
+    for (i = 0; i < rows * cols; i++) {
+        term->cells[i] = GUI_TERM_CELL(' ', term->attr);
+    }
+    gui_memset(term->dirty, 0, rows * 2 * sizeof(int16_t));
+
+    widget->user_data = term;
+    widget->on_draw   = _gui_terminal_draw;
+
+    /* opaque, every pixel is drawn by terminal itself */
+    widget->flag |= GUI_WIDGET_FLAG_RECT | GUI_WIDGET_FLAG_FILLED;
+    widget->gc.background = _gui_terminal_color(GUI_TERM_ATTR_BG(GUI_TERM_ATTR_DEFAULT));
+    widget->gc.font = font;
+    widget->gc.text_align = GUI_TEXT_OPAQUE;
+    gui_widget_set_rectangle(widget, rect->x1, rect->y1, GUI_RECT_WIDTH(rect), GUI_RECT_HEIGHT(rect));
+
+    return widget;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Write text to terminal.
+ * @param[in]  *widget  Terminal widget.
+ * @param[in]  *str     Text with VT100 escape sequences.
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Text is put on cursor position, screen scrolls up when cursor
+ *             goes under last row. Escape sequence may be split over calls.
+ *******************************************************************************
+ */
+void gui_terminal_write(widget_t *widget, const char *str)
+{
+    terminal_t *term;
+
+    ASSERT(widget != Co_NULL);
+    ASSERT(str != Co_NULL);
+    term = widget->user_data;
+
+    /* render task must not draw cells or dirty columns half written */
+    gui_window_begin_update(widget->top);
+
+    /* old cursor is wiped out */
+    _gui_terminal_touch(term, term->cy, MIN(term->cx, term->cols - 1), MIN(term->cx, term->cols - 1) + 1);
+
+    while (*str) {
+        _gui_terminal_putc(term, *str++);
+    }
+
+    _gui_terminal_touch(term, term->cy, MIN(term->cx, term->cols - 1), MIN(term->cx, term->cols - 1) + 1);
+
+    _gui_terminal_commit(widget);
+
+    gui_window_end_update(widget->top);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Clear terminal screen.
+ * @param[in]  *widget  Terminal widget.
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    All cells are cleared with default attribute, cursor goes back
+ *             to the first cell.
+ *******************************************************************************
+ */
+void gui_terminal_clear(widget_t *widget)
+{
+    ASSERT(widget != Co_NULL);
+
+    gui_terminal_write(widget, "\033[0m\033[2J\033[H");
+}
+
+/**
+ *******************************************************************************
+ * @brief      Draw cells of terminal.
+ * @param[in]  *widget  Terminal widget.
+ * @param[in]  *clip    Physical area to draw.
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Cells on area are drawn as opaque glyphs, so each pixel is
+ *             written once. Cursor cell is drawn in reverse colour.
+ *******************************************************************************
+ */
+static void _gui_terminal_draw(widget_t *widget, rect_t *clip)
+{
+    terminal_t *term = widget->user_data;
+    uint16_t *line;
+    color_t  foreground = widget->gc.foreground;
+    color_t  background = widget->gc.background;
+    int16_t  fw = term->font->width, fh = term->font->height;
+    int16_t  c1, c2, r1, r2, x, row;
+    uint8_t  attr;
+    rect_t   area;
+
+    /* move to logic area of widget */
+    area.x1 = clip->x1 - widget->extent.x1;
+    area.x2 = clip->x2 - widget->extent.x1;
+    area.y1 = clip->y1 - widget->extent.y1;
+    area.y2 = clip->y2 - widget->extent.y1;
+
+    /* space on right and bottom not filled by cells */
+    if (area.x2 > term->cols * fw || area.y2 > term->rows * fh) {
+        widget->dc_engine->engine->fill_rect(widget->dc_engine, &widget->inner_extent);
+    }
+
+    c1 = MAX(area.x1, 0) / fw;
+    c2 = MIN((area.x2 + fw - 1) / fw, term->cols);
+    r1 = MAX(area.y1, 0) / fh;
+    r2 = MIN((area.y2 + fh - 1) / fh, term->rows);
+
+    for (row = r1; row < r2; row++) {
+        line = _gui_terminal_line(term, row);
+
+        for (x = c1; x < c2; x++) {
+            attr = GUI_TERM_CELL_ATTR(line[x]);
+            if (x == term->cx && row == term->cy) {
+                attr = GUI_TERM_ATTR(GUI_TERM_ATTR_BG(attr), GUI_TERM_ATTR_FG(attr));
+            }
+
+            widget->gc.foreground = _gui_terminal_color(GUI_TERM_ATTR_FG(attr));
+            widget->gc.background = _gui_terminal_color(GUI_TERM_ATTR_BG(attr));
+            gui_lcd_putc(x * fw, row * fh, GUI_TERM_CELL_CHAR(line[x]), term->font, widget->dc_engine, &area);
+        }
+    }
+
+    widget->gc.foreground = foreground;
+    widget->gc.background = background;
+}
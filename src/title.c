@@ -52,20 +52,20 @@ void gui_title_create(window_t *win)
     gui_widget_set_rectangle(hide_btn, 32, 0, 20, 40);
 
     /* set title font style */
-    gui_widget_set_text_align(win->title, GUI_TEXT_ALIGN_LEFT|GUI_TEXT_ALIGN_MIDDLE);
+    gui_widget_set_text_align(win->title, GUI_TEXT_ALIGN_LEFT|GUI_TEXT_ALIGN_MIDDLE|GUI_TEXT_OPAQUE);
     gui_widget_set_font(win->title, &tm_font_16x26);
     gui_widget_set_text(win->title, win->title_name);
 
     /* symbol "X" */
     gui_widget_set_text_align(close_btn, GUI_TEXT_ALIGN_CENTER|GUI_TEXT_ALIGN_MIDDLE);
     gui_widget_set_font(close_btn, &tm_symbol_16x16);
-    gui_widget_set_text(close_btn, "!");
+    gui_widget_set_static_text(close_btn, "!");
     close_btn->gc.padding = GUI_PADDING(0,2,0,0);
 
     /* symbol "-" */
     gui_widget_set_text_align(hide_btn, GUI_TEXT_ALIGN_CENTER|GUI_TEXT_ALIGN_MIDDLE);
     gui_widget_set_font(hide_btn, &tm_symbol_16x16);
-    gui_widget_set_text(hide_btn, "\"");
+    gui_widget_set_static_text(hide_btn, "\"");
 
     /* set callbacks */
     close_btn->on_focus_in = gui_title_button_on_focus_in;
@@ -320,23 +320,172 @@ const uint16_t tm_font16x26[] = {
 0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x3F07,0x7FC7,0x73E7,0xF1FF,0xF07E,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [~]
 };
 
+/* glyph metrics of 11x18 font, bitmap columns with ink plus one column space */
+const struct font_glyph tm_font11x18_glyphs[] = {
+    { 0,  0,  5},     // sp
+    { 4,  2,  3},     // !
+    { 3,  5,  6},     // "
+    { 1,  9, 10},     // #
+    { 1,  8,  9},     // $
+    { 0, 10, 11},     // %
+    { 1,  9, 10},     // &
+    { 4,  2,  3},     // '
+    { 4,  5,  6},     // (
+    { 2,  5,  6},     // )
+    { 2,  6,  7},     // *
+    { 0, 10, 11},     // +
+    { 4,  2,  3},     // ,
+    { 3,  4,  5},     // -
+    { 4,  2,  3},     // .
+    { 3,  5,  6},     // /
+    { 1,  8,  9},     // 0
+    { 2,  5,  6},     // 1
+    { 1,  8,  9},     // 2
+    { 1,  8,  9},     // 3
+    { 1,  8,  9},     // 4
+    { 1,  8,  9},     // 5
+    { 1,  8,  9},     // 6
+    { 1,  8,  9},     // 7
+    { 1,  8,  9},     // 8
+    { 1,  8,  9},     // 9
+    { 4,  2,  3},     // :
+    { 4,  2,  3},     // ;
+    { 1,  8,  9},     // <
+    { 1,  8,  9},     // =
+    { 1,  8,  9},     // >
+    { 1,  9, 10},     // ?
+    { 1,  8,  9},     // @
+    { 1,  9, 10},     // A
+    { 1,  8,  9},     // B
+    { 1,  8,  9},     // C
+    { 1,  8,  9},     // D
+    { 1,  8,  9},     // E
+    { 1,  8,  9},     // F
+    { 1,  8,  9},     // G
+    { 1,  8,  9},     // H
+    { 2,  6,  7},     // I
+    { 1,  8,  9},     // J
+    { 1,  9, 10},     // K
+    { 1,  8,  9},     // L
+    { 1,  9, 10},     // M
+    { 1,  8,  9},     // N
+    { 1,  8,  9},     // O
+    { 1,  8,  9},     // P
+    { 1,  9, 10},     // Q
+    { 1,  9, 10},     // R
+    { 1,  8,  9},     // S
+    { 0, 10, 11},     // T
+    { 1,  8,  9},     // U
+    { 1,  9, 10},     // V
+    { 0, 10, 11},     // W
+    { 0, 10, 11},     // X
+    { 0, 10, 11},     // Y
+    { 1,  8,  9},     // Z
+    { 4,  4,  5},     // [
+    { 3,  5,  6},     // backslash
+    { 3,  4,  5},     // ]
+    { 1,  8,  9},     // ^
+    { 0, 11, 12},     // _
+    { 2,  4,  5},     // `
+    { 1,  9, 10},     // a
+    { 1,  8,  9},     // b
+    { 1,  8,  9},     // c
+    { 1,  8,  9},     // d
+    { 1,  8,  9},     // e
+    { 1,  9, 10},     // f
+    { 1,  8,  9},     // g
+    { 1,  8,  9},     // h
+    { 2,  5,  6},     // i
+    { 1,  6,  7},     // j
+    { 1,  9, 10},     // k
+    { 2,  5,  6},     // l
+    { 0, 10, 11},     // m
+    { 1,  8,  9},     // n
+    { 1,  8,  9},     // o
+    { 1,  8,  9},     // p
+    { 1,  8,  9},     // q
+    { 1,  8,  9},     // r
+    { 1,  8,  9},     // s
+    { 1,  8,  9},     // t
+    { 1,  8,  9},     // u
+    { 1,  9, 10},     // v
+    { 0,  9, 10},     // w
+    { 1,  8,  9},     // x
+    { 1,  8,  9},     // y
+    { 1,  9, 10},     // z
+    { 3,  6,  7},     // {
+    { 5,  2,  3},     // |
+    { 2,  6,  7},     // }
+    { 1,  8,  9},     // ~
+};
+
+/* kerning pairs of 11x18 font, sorted */
+const struct font_kern tm_font11x18_kerning[] = {
+    {GUI_FONT_KERN_PAIR('A', 'T'), -1},
+    {GUI_FONT_KERN_PAIR('A', 'V'), -1},
+    {GUI_FONT_KERN_PAIR('A', 'W'), -1},
+    {GUI_FONT_KERN_PAIR('A', 'Y'), -1},
+    {GUI_FONT_KERN_PAIR('F', ','), -2},
+    {GUI_FONT_KERN_PAIR('F', '.'), -2},
+    {GUI_FONT_KERN_PAIR('L', 'T'), -1},
+    {GUI_FONT_KERN_PAIR('L', 'V'), -1},
+    {GUI_FONT_KERN_PAIR('L', 'Y'), -1},
+    {GUI_FONT_KERN_PAIR('P', ','), -2},
+    {GUI_FONT_KERN_PAIR('P', '.'), -2},
+    {GUI_FONT_KERN_PAIR('T', ','), -2},
+    {GUI_FONT_KERN_PAIR('T', '.'), -2},
+    {GUI_FONT_KERN_PAIR('T', 'A'), -1},
+    {GUI_FONT_KERN_PAIR('T', 'a'), -1},
+    {GUI_FONT_KERN_PAIR('T', 'e'), -1},
+    {GUI_FONT_KERN_PAIR('T', 'o'), -1},
+    {GUI_FONT_KERN_PAIR('V', 'A'), -1},
+    {GUI_FONT_KERN_PAIR('V', 'a'), -1},
+    {GUI_FONT_KERN_PAIR('V', 'o'), -1},
+    {GUI_FONT_KERN_PAIR('W', 'A'), -1},
+    {GUI_FONT_KERN_PAIR('Y', 'A'), -1},
+    {GUI_FONT_KERN_PAIR('Y', 'o'), -1},
+};
+
 font_t tm_font_7x10 = {
     "tm",
 	7,
 	10,
-	tm_font7x10
+	tm_font7x10,
+	Co_NULL,
+	Co_NULL,
+	0,
+	Co_NULL
 };
 
 font_t tm_font_11x18 = {
     "tm",
 	11,
 	18,
-	tm_font11x18
+	tm_font11x18,
+	Co_NULL,
+	Co_NULL,
+	0,
+	Co_NULL
 };
 
 font_t tm_font_16x26 = {
     "tm",
 	16,
 	26,
-	tm_font16x26
+	tm_font16x26,
+	Co_NULL,
+	Co_NULL,
+	0,
+	Co_NULL
+};
+
+font_t tm_font_11x18_prop = {
+    "tm",
+	11,
+	18,
+	tm_font11x18,
+	tm_font11x18_glyphs,
+	tm_font11x18_kerning,
+	sizeof(tm_font11x18_kerning) / sizeof(tm_font11x18_kerning[0]),
+	Co_NULL
 };
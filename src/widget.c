@@ -10,9 +10,13 @@
 #include <cogui.h>
 
 extern font_t *default_font; 
+
+#define GUI_WIDGET_TEXT_MIN_CAP     16          /* smallest text buffer */
 extern window_t *main_page;
 
 StatusType gui_widget_event_handler(widget_t *widget, event_t *event);
+static void _gui_widget_calc_extent(widget_t *widget);
+static void _gui_widget_free_text(widget_t *widget);
 
 static void _gui_widget_init(widget_t *widget)
 {
@@ -25,6 +29,7 @@ static void _gui_widget_init(widget_t *widget)
 	widget->gc.foreground = white;
 	widget->gc.background = black;
     widget->gc.font       = default_font;
+    widget->gc.alpha      = 255;
 
     /* initial extent rectangle */
     GUI_INIT_RECT(&widget->extent);
@@ -55,26 +60,46 @@ widget_t *gui_widget_create(struct window *top)
     widget->dc_engine = gui_dc_begin_drawing(widget);
     ASSERT(widget->dc_engine != Co_NULL);
 
+    /* render task may be walking the list */
+    gui_render_lock();
+
     widget->top = top;
     widget->id  = top->widget_cnt++;
 
     gui_widget_list_insert(widget);
 
     top->focus_widget = widget;
+
+    gui_render_unlock();
+
     return widget;
 }
 
 void gui_widget_delete(widget_t *widget)
 {
+    /* render task must not paint a node being freed */
+    gui_render_lock();
+
+    /* children go away with their container */
+    while (widget->children != Co_NULL) {
+        gui_widget_delete(widget->children);
+    }
+
+    if (widget->top->scroll_widget == widget) {
+        widget->top->scroll_widget = Co_NULL;
+    }
+
     gui_widget_list_pop(widget->id, widget->top);
     gui_dc_end_drawing(widget->dc_engine);
-    gui_widget_clear_text(widget);
+    _gui_widget_free_text(widget);
 
     if (widget->user_data) {
         gui_free(widget->user_data);
     }
 
     gui_free(widget);
+
+    gui_render_unlock();
 }
 
 /**
@@ -133,14 +158,21 @@ void gui_widget_list_insert(widget_t *node)
     struct window *top = node->top;
     ASSERT(top != Co_NULL);
 
+    /* child widget goes to the end of its container's list */
+    if (node->parent != Co_NULL && node->parent->children == Co_NULL) {
+        node->parent->children = node;
+        node->next = Co_NULL;
+        return;
+    }
+
     /* if it is header node */
-    if (top->widget_list == Co_NULL) {
+    if (node->parent == Co_NULL && top->widget_list == Co_NULL) {
         top->widget_list = node;
         node->next = Co_NULL;
         return;
     }
 
-    widget_t *list = top->widget_list;
+    widget_t *list = node->parent != Co_NULL ? node->parent->children : top->widget_list;
 
     while (list->next != Co_NULL)
         list = list->next;
@@ -167,28 +199,32 @@ void gui_widget_list_insert(widget_t *node)
 widget_t *gui_widget_list_pop(uint32_t id, struct window *top)
 {
     ASSERT(top != Co_NULL);
-    widget_t *list = top->widget_list;
-    if (list == Co_NULL) {
+    if (top->widget_list == Co_NULL) {
         return Co_NULL;
     }
 
-    /* recursive from first node */
-    while (list->next != Co_NULL) {
-        if (list->next->id == id) {
-            widget_t *tmp_widget = list->next;
-            
-            list->next = tmp_widget->next;
-
-            tmp_widget->next = Co_NULL;
-            
-            return tmp_widget;
-        }
+    widget_t *node = gui_get_widget_node(id, top);
+    if (node == Co_NULL) {
+        return Co_NULL;
+    }
 
-        /* or move to next one */
+    /* child widget is linked in its container's list */
+    widget_t *list = node->parent != Co_NULL ? node->parent->children : top->widget_list;
+
+    if (list == node) {
+        node->parent->children = node->next;
+        node->next = Co_NULL;
+        return node;
+    }
+
+    while (list->next != node) {
         list = list->next;
     }
 
-    return Co_NULL;
+    list->next = node->next;
+    node->next = Co_NULL;
+
+    return node;
 }
 
 /**
@@ -200,9 +236,9 @@ widget_t *gui_widget_list_pop(uint32_t id, struct window *top)
  * @retval     Co_NULL      Or we did not find it
  *******************************************************************************
  */
-widget_t *gui_get_widget_node(uint32_t id, struct window *top)
+static widget_t *_gui_get_widget_node(uint32_t id, widget_t *list)
 {
-    widget_t *list = top->widget_list->next;
+    widget_t *node;
 
     /* recursive from first node */
     while (list != Co_NULL) {
@@ -211,6 +247,12 @@ widget_t *gui_get_widget_node(uint32_t id, struct window *top)
             return list;
         }
 
+        /* then search its children */
+        node = _gui_get_widget_node(id, list->children);
+        if (node != Co_NULL) {
+            return node;
+        }
+
         /* or move to next one */
         list = list->next;
     }
@@ -218,6 +260,102 @@ widget_t *gui_get_widget_node(uint32_t id, struct window *top)
     return Co_NULL;
 }
 
+widget_t *gui_get_widget_node(uint32_t id, struct window *top)
+{
+    return _gui_get_widget_node(id, top->widget_list->next);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Create a container widget
+ * @param[in]  *top     Which window container belongs to
+ * @param[out] None
+ * @retval     *widget  The container we create
+ *
+ * @par Description
+ * @details    This function is used to create a widget which can hold child
+ *             widgets. Children are placed relative to the container, painted
+ *             on top of it, clipped by it and moved along with it.
+ *******************************************************************************
+ */
+widget_t *gui_container_create(struct window *top)
+{
+    widget_t *widget = gui_widget_create(top);
+    if (widget == Co_NULL) {
+        return Co_NULL;
+    }
+
+    widget->flag |= GUI_WIDGET_TYPE_CONTAINER;
+
+    return widget;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Put a widget into container
+ * @param[in]  *container   Container to hold the child
+ * @param[in]  *child       Widget to put in
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    This function is used to move a widget from its current list to
+ *             the end of container's children. Rectangle of child is used as
+ *             relative to container after that.
+ *******************************************************************************
+ */
+void gui_container_add_child(widget_t *container, widget_t *child)
+{
+    ASSERT(container != Co_NULL && child != Co_NULL);
+    ASSERT(GUI_WIDGET_IS_CONTAINER(container));
+    ASSERT(container->top == child->top);
+
+    gui_render_lock();
+
+    gui_widget_list_pop(child->id, child->top);
+
+    child->parent = container;
+    gui_widget_list_insert(child);
+
+    /* compute extent from the new parent */
+    gui_widget_update_extent(container);
+    _gui_widget_calc_extent(child);
+
+    gui_render_unlock();
+}
+
+/**
+ *******************************************************************************
+ * @brief      Take a widget out of container
+ * @param[in]  *container   Container holds the child
+ * @param[in]  *child       Widget to take out
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    This function is used to move a child back to top level of its
+ *             window, it keeps its current physical position.
+ *******************************************************************************
+ */
+void gui_container_remove_child(widget_t *container, widget_t *child)
+{
+    ASSERT(container != Co_NULL && child != Co_NULL);
+    ASSERT(child->parent == container);
+
+    gui_render_lock();
+
+    gui_widget_update_extent(child);
+    gui_widget_list_pop(child->id, child->top);
+
+    child->parent = Co_NULL;
+    child->rel_extent = child->extent;
+    gui_widget_list_insert(child);
+
+    _gui_widget_calc_extent(child);
+
+    gui_render_unlock();
+}
+
 void gui_widget_set_focus(widget_t *widget, event_handler_ptr handler)
 {
     ASSERT(widget != Co_NULL);
@@ -238,6 +376,9 @@ void gui_widget_focus(widget_t *widget)
 
     window_t *win = widget->top;
 
+    /* old and new focus widget are painted together */
+    gui_window_begin_update(win);
+
     if (win->focus_widget != Co_NULL) {
         gui_widget_unfocus(win->focus_widget);
     }
@@ -245,7 +386,8 @@ void gui_widget_focus(widget_t *widget)
     widget->flag |= GUI_WIDGET_FLAG_FOCUS;
 
     if (win->focus_widget == widget) {
-        gui_window_refresh(win);
+        gui_widget_invalidate(widget);
+        gui_window_end_update(win);
         return;
     }
     else {
@@ -259,7 +401,9 @@ void gui_widget_focus(widget_t *widget)
     /* put this node into last of the list */
     gui_widget_list_pop(widget->id, win);
     gui_widget_list_insert(widget);
-    gui_window_update(win, widget);
+    gui_widget_invalidate(widget);
+
+    gui_window_end_update(win);
 }
 
 void gui_widget_unfocus(widget_t *widget)
@@ -274,7 +418,7 @@ void gui_widget_unfocus(widget_t *widget)
         widget->on_focus_out(widget, Co_NULL);
     }
 
-    gui_window_refresh(widget->top);
+    gui_widget_invalidate(widget);
 }
 
 void gui_widget_get_rect(widget_t *widget, rect_t *rect)
@@ -283,8 +427,8 @@ void gui_widget_get_rect(widget_t *widget, rect_t *rect)
 
     if (rect != Co_NULL) {
         rect->x1 = rect->y1 = 0;
-        rect->x2 = widget->extent.x2 - widget->extent.x1;
-        rect->y2 = widget->extent.y2 - widget->extent.y1;
+        rect->x2 = widget->rel_extent.x2 - widget->rel_extent.x1;
+        rect->y2 = widget->rel_extent.y2 - widget->rel_extent.y1;
     }
 }
 
@@ -293,23 +437,146 @@ void gui_widget_get_extent(widget_t *widget, rect_t *rect)
     ASSERT(widget != Co_NULL);
     ASSERT(rect != Co_NULL);
 
+    gui_widget_update_extent(widget);
+
     *rect = widget->extent;
 }
 
+/**
+ *******************************************************************************
+ * @brief      Get extent of widget limited by its containers and window
+ * @param[in]  *widget  Which widget to get
+ * @param[out] *rect    Physical extent can be painted
+ * @retval     1        Widget has something to paint
+ * @retval     0        Widget is fully outside its containers
+ *******************************************************************************
+ */
+bool_t gui_widget_get_clip_extent(widget_t *widget, rect_t *rect)
+{
+    widget_t *parent;
+
+    ASSERT(widget != Co_NULL);
+    ASSERT(rect != Co_NULL);
+
+    gui_widget_get_extent(widget, rect);
+
+    for (parent = widget->parent; parent != Co_NULL; parent = parent->parent) {
+        if (!gui_rect_intersect(rect, &parent->extent, rect)) {
+            return 0;
+        }
+    }
+
+    if (widget->top != Co_NULL) {
+        return gui_rect_intersect(rect, &widget->top->extent, rect);
+    }
+
+    return 1;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Request repaint of a widget
+ * @param[in]  *widget  Which widget to repaint
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    This function is called to mark the area of widget damaged on
+ *             its window. Nothing is done if window is not on screen.
+ *******************************************************************************
+ */
+void gui_widget_invalidate(widget_t *widget)
+{
+    rect_t rect;
+
+    ASSERT(widget != Co_NULL);
+
+    /* nothing to paint for hidden window, unless it has backing store */
+    if (!GUI_WINDOW_IS_ENABLE(widget->top) && widget->top->store == Co_NULL) {
+        return;
+    }
+
+    if (gui_widget_get_clip_extent(widget, &rect)) {
+        gui_window_invalidate(widget->top, &rect);
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Make physical extent of widget up to date
+ * @param[in]  *widget  Which widget to check
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Physical extent of a child widget is computed from its parent
+ *             and cached. Moving a container does not touch its children, the
+ *             cache is rebuilt here when it finds parent origin has changed.
+ *******************************************************************************
+ */
+void gui_widget_update_extent(widget_t *widget)
+{
+    widget_t *parent = widget->parent;
+
+    /* top level widget is placed relative to its window */
+    if (parent == Co_NULL) {
+        if (widget->top != Co_NULL &&
+            (widget->origin.x != widget->top->extent.x1 || widget->origin.y != widget->top->extent.y1)) {
+            _gui_widget_calc_extent(widget);
+        }
+        return;
+    }
+
+    gui_widget_update_extent(parent);
+
+    if (widget->origin.x != parent->extent.x1 - parent->scroll.x ||
+        widget->origin.y != parent->extent.y1 - parent->scroll.y) {
+        _gui_widget_calc_extent(widget);
+    }
+}
+
+static void _gui_widget_calc_extent(widget_t *widget)
+{
+    /* parent extent should be up to date before calling */
+    if (widget->parent != Co_NULL) {
+        /* scrolled container moves its children back */
+        widget->origin.x = widget->parent->extent.x1 - widget->parent->scroll.x;
+        widget->origin.y = widget->parent->extent.y1 - widget->parent->scroll.y;
+    }
+    else if (widget->top != Co_NULL) {
+        widget->origin.x = widget->top->extent.x1;
+        widget->origin.y = widget->top->extent.y1;
+    }
+    else {
+        widget->origin.x = widget->origin.y = 0;
+    }
+
+    widget->extent.x1 = widget->rel_extent.x1 + widget->origin.x;
+    widget->extent.x2 = widget->rel_extent.x2 + widget->origin.x;
+    widget->extent.y1 = widget->rel_extent.y1 + widget->origin.y;
+    widget->extent.y2 = widget->rel_extent.y2 + widget->origin.y;
+}
+
 static void gui_widget_set_rect(widget_t *widget, rect_t *rect)
 {
     if (widget == Co_NULL || rect == Co_NULL)
 	    return;
 
-    widget->extent = *rect;
+    widget->rel_extent = *rect;
+
+    if (widget->parent != Co_NULL) {
+        gui_widget_update_extent(widget->parent);
+    }
+    _gui_widget_calc_extent(widget);
 
-    widget->min_width  = widget->extent.x2 - widget->extent.x1;
-    widget->min_height = widget->extent.y2 - widget->extent.y1;
+    widget->min_width  = widget->rel_extent.x2 - widget->rel_extent.x1;
+    widget->min_height = widget->rel_extent.y2 - widget->rel_extent.y1;
 }
 
 void gui_widget_set_rectangle(widget_t *widget, int32_t x, int32_t y, int32_t width, int32_t height)
 {
-    if (!(widget->top->style & GUI_WINDOW_STYLE_NO_TITLE) && !(widget->flag & GUI_WIDGET_FLAG_TITLE) && !(widget->flag & GUI_WIDGET_FLAG_HEADER) ) {
+    /* children are placed inside their container, title is not a problem */
+    if (widget->parent == Co_NULL && !(widget->top->style & GUI_WINDOW_STYLE_NO_TITLE) && !(widget->flag & GUI_WIDGET_FLAG_TITLE) && !(widget->flag & GUI_WIDGET_FLAG_HEADER) ) {
         if (y <= GUI_WINTITLE_HEIGHT)
             y = GUI_WINTITLE_HEIGHT+1;
     }
@@ -350,7 +617,7 @@ void gui_widget_enable_border(widget_t *widget)
 
     widget->flag |= GUI_WIDGET_BORDER;
 
-    gui_window_refresh(widget->top);
+    gui_widget_invalidate(widget);
 }
 
 void gui_widget_set_font(widget_t* widget, font_t *font)
@@ -368,18 +635,234 @@ void gui_widget_set_text_align(widget_t *widget, uint16_t style)
     widget->gc.text_align = style;
 }
 
+/**
+ *******************************************************************************
+ * @brief      Mark changed text of widget damaged
+ * @param[in]  *widget  Which widget text changed
+ * @param[in]  *old     Text before change, Co_NULL if it had none
+ * @param[in]  *text    Text after change
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    If new text keeps every character in its cell, that is the
+ *             same length on one line of fixed width font, only the cells
+ *             whose character changed are repainted. Otherwise the whole
+ *             widget is repainted.
+ *******************************************************************************
+ */
+static void _gui_widget_invalidate_text(widget_t *widget, const char *old, const char *text)
+{
+    font_t   *font = widget->gc.font;
+    int32_t  len;
+    int32_t  padding = widget->gc.padding;
+    point_t  origin;
+    rect_t   pr, cell, bound;
+    int32_t  i;
+
+    if (!COGUI_WIDGET_IS_ENABLE(widget)) {
+        return;
+    }
+
+    pr = widget->inner_extent;
+    GUI_RECT_PADDING(&pr, padding);
+
+    len = gui_strlen(text);
+    if (old == Co_NULL || !GUI_FONT_IS_MONO(font) || widget->text_len != len ||
+        len * font->width > GUI_RECT_WIDTH(&pr)) {
+        gui_widget_invalidate(widget);
+        return;
+    }
+
+    for (i = 0; i < len; i++) {
+        if (text[i] == '\n' || old[i] == '\n') {
+            gui_widget_invalidate(widget);
+            return;
+        }
+    }
+
+    /* cells out of parents are not shown either */
+    if (!gui_widget_get_clip_extent(widget, &bound)) {
+        return;
+    }
+
+    gui_dc_get_text_origin(widget->dc_engine, &pr, (char *)text, &origin);
+
+    for (i = 0; i < len; i++) {
+        if (text[i] == old[i]) {
+            continue;
+        }
+
+        cell.x1 = pr.x1 + origin.x + i * font->width;
+        cell.x2 = cell.x1 + font->width;
+        cell.y1 = pr.y1 + origin.y;
+        cell.y2 = cell.y1 + font->height;
+
+        /* glyph is clipped by widget, so is its cell */
+        if (!gui_rect_intersect(&cell, &widget->inner_extent, &cell)) {
+            continue;
+        }
+
+        gui_widget_rect_l2p(widget, &cell);
+        if (gui_rect_intersect(&cell, &bound, &cell)) {
+            gui_window_invalidate(widget->top, &cell);
+        }
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Make room for text of widget
+ * @param[in]  *widget  Which widget
+ * @param[in]  len      Text length needed, without ending zero
+ * @param[out] None
+ * @retval     GUI_E_OK     Widget owns a buffer large enough
+ * @retval     GUI_E_ERROR  Out of memory, text is not changed
+ *
+ * @par Description
+ * @details    Buffer grows to double size at least, so appending many times
+ *             copies text only a few times. Current text is kept, borrowed
+ *             text is copied into the new buffer.
+ *******************************************************************************
+ */
+static StatusType _gui_widget_reserve_text(widget_t *widget, uint64_t len)
+{
+    uint64_t cap;
+    char     *buf;
+
+    if (len < widget->text_cap) {
+        return GUI_E_OK;
+    }
+
+    cap = MAX(MAX((uint64_t)widget->text_cap * 2, len + 1), GUI_WIDGET_TEXT_MIN_CAP);
+    if (cap > 0xFFFF) {
+        cap = 0xFFFF;
+        if (len >= cap) {
+            return GUI_E_ERROR;
+        }
+    }
+
+    buf = gui_malloc(cap);
+    if (buf == Co_NULL) {
+        return GUI_E_ERROR;
+    }
+
+    if (widget->text != Co_NULL && (widget->flag & GUI_WIDGET_FLAG_HAS_TEXT)) {
+        gui_memcpy(buf, widget->text, widget->text_len + 1);
+    }
+    else {
+        buf[0] = 0;
+        widget->text_len = 0;
+    }
+
+    if (widget->text_cap > 0) {
+        gui_free(widget->text);
+    }
+
+    widget->text     = buf;
+    widget->text_cap = cap;
+
+    return GUI_E_OK;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Drop text of widget
+ * @param[in]  *widget  Which widget
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Buffer is freed only if widget owns it. Caller holds the render
+ *             lock.
+ *******************************************************************************
+ */
+static void _gui_widget_free_text(widget_t *widget)
+{
+    widget->flag &= ~GUI_WIDGET_FLAG_HAS_TEXT;
+
+    /* free text buffer if widget owns it */
+    if (widget->text_cap > 0) {
+        gui_free(widget->text);
+    }
+
+    widget->text     = Co_NULL;
+    widget->text_len = 0;
+    widget->text_cap = 0;
+}
+
 void gui_widget_set_text(widget_t *widget, const char *text)
+{
+    uint64_t len;
+
+    ASSERT(widget != Co_NULL);
+    ASSERT(text != Co_NULL);
+
+    if (text == widget->text) {
+        return;
+    }
+
+    len = gui_strlen(text);
+
+    /* painting waits until the new text is in place */
+    gui_window_begin_update(widget->top);
+
+    if (_gui_widget_reserve_text(widget, len) == GUI_E_OK) {
+        /* repaint only what changed */
+        _gui_widget_invalidate_text(widget, (widget->flag & GUI_WIDGET_FLAG_HAS_TEXT) ? widget->text : Co_NULL, text);
+
+        gui_memcpy(widget->text, text, len + 1);
+        widget->text_len = len;
+        widget->flag |= GUI_WIDGET_FLAG_HAS_TEXT;
+    }
+
+    gui_window_end_update(widget->top);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Set text of widget without copying it
+ * @param[in]  *widget  Which widget
+ * @param[in]  *text    Text kept by caller, must not change while it is used
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    This function is used for constant labels. Widget borrows the
+ *             text, it is copied only when more text is appended.
+ *******************************************************************************
+ */
+void gui_widget_set_static_text(widget_t *widget, const char *text)
 {
     ASSERT(widget != Co_NULL);
+    ASSERT(text != Co_NULL);
+
+    if (text == widget->text) {
+        return;
+    }
+
+    gui_window_begin_update(widget->top);
 
+    _gui_widget_invalidate_text(widget, (widget->flag & GUI_WIDGET_FLAG_HAS_TEXT) ? widget->text : Co_NULL, text);
+
+    if (widget->text_cap > 0) {
+        gui_free(widget->text);
+    }
+
+    widget->text     = (char *)text;
+    widget->text_len = gui_strlen(text);
+    widget->text_cap = 0;
     widget->flag |= GUI_WIDGET_FLAG_HAS_TEXT;
-    
-    widget->text = gui_strdup(text);
+
+    gui_window_end_update(widget->top);
 }
 
 void gui_widget_append_text(widget_t *widget, const char *text)
 {
+    uint64_t len;
+
     ASSERT(widget != Co_NULL);
+    ASSERT(text != Co_NULL);
     
     /* if this is first text, just call set_text to do finish work */
     if (!(widget->flag & GUI_WIDGET_FLAG_HAS_TEXT)) {
@@ -387,38 +870,87 @@ void gui_widget_append_text(widget_t *widget, const char *text)
         return;
     }
     
-    uint64_t len = gui_strlen(text) + gui_strlen(widget->text) + 1;
-    char * new_text = (char *)gui_malloc(len);
+    len = gui_strlen(text);
 
-    /* create new string and put 'text' on original text's end */
-    gui_memcpy(new_text, widget->text, gui_strlen(widget->text));
-    gui_memcpy(new_text+gui_strlen(widget->text), text, gui_strlen(text)+1);
+    /* buffer may be moved, render task must not read it meanwhile */
+    gui_window_begin_update(widget->top);
 
-    /* after copy original text, free it */
-    gui_free(widget->text);
+    if (_gui_widget_reserve_text(widget, widget->text_len + len) == GUI_E_OK) {
+        /* put 'text' on original text's end */
+        gui_memcpy(widget->text + widget->text_len, text, len + 1);
+        widget->text_len += len;
 
-    widget->text = new_text;
+        if (COGUI_WIDGET_IS_ENABLE(widget)) {
+            gui_widget_invalidate(widget);
+        }
+    }
+
+    gui_window_end_update(widget->top);
 }
 
 void gui_widget_clear_text(widget_t *widget)
 {
-    widget->flag &= ~GUI_WIDGET_FLAG_HAS_TEXT;
+    ASSERT(widget != Co_NULL);
 
-    /* free text pointer if needed */
-    if (widget->text) {
-        gui_free(widget->text);
+    gui_window_begin_update(widget->top);
+
+    if ((widget->flag & GUI_WIDGET_FLAG_HAS_TEXT) && COGUI_WIDGET_IS_ENABLE(widget)) {
+        gui_widget_invalidate(widget);
+    }
+
+    _gui_widget_free_text(widget);
+
+    gui_window_end_update(widget->top);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Set picture of widget
+ * @param[in]  *widget  Which widget to set
+ * @param[in]  *image   Picture drawn in middle of widget, Co_NULL for none
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Picture is drawn over fill and under text. Image is borrowed,
+ *             it must be kept as long as widget uses it.
+ *******************************************************************************
+ */
+void gui_widget_set_image(widget_t *widget, const struct image *image)
+{
+    ASSERT(widget != Co_NULL);
+
+    if (image == widget->image) {
+        return;
+    }
+
+    widget->image = image;
+
+    if (COGUI_WIDGET_IS_ENABLE(widget)) {
+        gui_widget_invalidate(widget);
     }
 }
 
 static void _gui_widget_move(widget_t *widget, int32_t dx, int32_t dy)
 {
-    widget->extent.x1 += dx;
-    widget->extent.x2 += dx;
+    /* old and new place are painted together */
+    gui_window_begin_update(widget->top);
+    gui_widget_invalidate(widget);
 
-    widget->extent.y1 += dy;
-    widget->extent.y2 += dy;
+    widget->rel_extent.x1 += dx;
+    widget->rel_extent.x2 += dx;
 
-	gui_window_refresh(widget->top);
+    widget->rel_extent.y1 += dy;
+    widget->rel_extent.y2 += dy;
+
+    /* children follow lazily, see gui_widget_update_extent */
+    if (widget->parent != Co_NULL) {
+        gui_widget_update_extent(widget->parent);
+    }
+    _gui_widget_calc_extent(widget);
+
+    gui_widget_invalidate(widget);
+    gui_window_end_update(widget->top);
 }
 
 void gui_widget_move_to_logic(widget_t *widget, int32_t dx, int32_t dy)
@@ -436,6 +968,8 @@ void gui_widget_move_to_phy(widget_t *widget, int32_t x, int32_t y)
         return;
     }
 
+    gui_widget_update_extent(widget);
+
     int32_t dx = x - widget->extent.x1;
     int32_t dy = y - widget->extent.y1;
 	
@@ -446,6 +980,8 @@ void gui_widget_point_l2p(widget_t *widget, point_t *point)
 {
     ASSERT(widget != Co_NULL);
 
+    gui_widget_update_extent(widget);
+
     if (point != Co_NULL) {
         point->x += widget->extent.x1;
         point->y += widget->extent.y1;
@@ -456,6 +992,8 @@ void gui_widget_rect_l2p(widget_t *widget, rect_t *rect)
 {
     ASSERT(widget != Co_NULL);
 
+    gui_widget_update_extent(widget);
+
     if (rect != Co_NULL) {
         rect->x1 += widget->extent.x1;
         rect->x2 += widget->extent.x1;
@@ -469,6 +1007,8 @@ void gui_widget_point_p2l(widget_t *widget, point_t *point)
 {
     ASSERT(widget != Co_NULL);
 
+    gui_widget_update_extent(widget);
+
     if (point != Co_NULL) {
         point->x -= widget->extent.x1;
         point->y -= widget->extent.y1;
@@ -478,6 +1018,8 @@ void gui_widget_point_p2l(widget_t *widget, point_t *point)
 void gui_widget_rect_p2l(widget_t *widget, rect_t *rect)
 {
     ASSERT(widget != Co_NULL);
+
+    gui_widget_update_extent(widget);
     
     if (rect != Co_NULL) {
         rect->x1 -= widget->extent.x1;
@@ -544,7 +1086,7 @@ StatusType gui_widget_onhide(widget_t *widget, event_t *event)
         return GUI_E_ERROR;
     }
 
-	gui_window_refresh(widget->top);
+	gui_widget_invalidate(widget);
 
     return GUI_E_OK;
 }
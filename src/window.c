@@ -12,6 +12,9 @@
 extern window_t *main_page;
 window_t *current_window;
 int16_t current_app_install_cnt = 0;
+
+static window_t *window_stack = Co_NULL;    /* bottom window in z-order        */
+static rect_t    window_exposed;            /* screen area uncovered by windows */
 struct main_app_table main_app_table[9];
 
 static StatusType gui_window_event_handler(window_t * win, event_t *event);
@@ -28,6 +31,82 @@ static void _gui_window_init(window_t *win)
 
     win->flag       = GUI_WINDOW_FLAG_INIT;
     win->handler    = gui_window_event_handler;
+
+    /* window covers whole screen by default */
+    GUI_SET_RECT(&win->extent, 0, 0, COGUI_SCREEN_WIDTH, COGUI_SCREEN_HEIGHT);
+}
+
+/**
+ *******************************************************************************
+ * @brief      Get the top window in z-order
+ * @param[in]  None
+ * @param[out] None
+ * @retval     *win     Top window
+ * @retval     Co_NULL  No window is shown
+ *******************************************************************************
+ */
+static window_t *_gui_window_stack_top(void)
+{
+    window_t *win = window_stack;
+
+    while (win != Co_NULL && win->above != Co_NULL) {
+        win = win->above;
+    }
+
+    return win;
+}
+
+static void _gui_window_stack_remove(window_t *win)
+{
+    if (win->below != Co_NULL) {
+        win->below->above = win->above;
+    }
+    else if (window_stack == win) {
+        window_stack = win->above;
+    }
+
+    if (win->above != Co_NULL) {
+        win->above->below = win->below;
+    }
+
+    win->above = win->below = Co_NULL;
+    current_window = _gui_window_stack_top();
+}
+
+static void _gui_window_stack_push(window_t *win)
+{
+    window_t *top = _gui_window_stack_top();
+
+    win->below = top;
+    win->above = Co_NULL;
+
+    if (top != Co_NULL) {
+        top->above = win;
+    }
+    else {
+        window_stack = win;
+    }
+
+    current_window = win;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Point backing store to current window position
+ * @param[in]  *win     Window with backing store
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Store buffer address is moved back by window position, so the
+ *             store is drawn with physical coordinates like the screen.
+ *******************************************************************************
+ */
+static void _gui_window_locate_store(window_t *win)
+{
+    graphic_driver_t *store = win->store;
+
+    store->frame_buffer = (uint32_t)(store + 1) - win->extent.y1 * store->pitch - win->extent.x1 * GUI_FB_BPP(store);
 }
 
 window_t *gui_window_create(uint16_t style)
@@ -61,9 +140,9 @@ window_t *gui_main_window_create(void)
     widget = gui_widget_create(win);
     gui_widget_set_rectangle(widget, 0, 0, 240, 40);
     widget->flag |= GUI_WIDGET_FLAG_RECT | GUI_WIDGET_FLAG_FILLED;
-    gui_widget_set_text(widget, "CoOS");
+    gui_widget_set_static_text(widget, "CoOS");
     gui_widget_set_font(widget, &tm_font_16x26);
-    gui_widget_set_text_align(widget, GUI_TEXT_ALIGN_CENTER|GUI_TEXT_ALIGN_MIDDLE);
+    gui_widget_set_text_align(widget, GUI_TEXT_ALIGN_CENTER|GUI_TEXT_ALIGN_MIDDLE|GUI_TEXT_OPAQUE);
     GUI_WIDGET_ENABLE(widget);
 
     for ( i=0; i<9; i++) {
@@ -79,7 +158,7 @@ window_t *gui_main_window_create(void)
         widget = gui_widget_create(win);
         gui_widget_set_rectangle(widget, 15 + (i%3)*75 , 115 + (i/3)*88, 60, 13);
         widget->flag |= GUI_WIDGET_FLAG_RECT| GUI_WIDGET_FLAG_FILLED;
-        gui_widget_set_text_align(widget, GUI_TEXT_ALIGN_CENTER|GUI_TEXT_ALIGN_MIDDLE);
+        gui_widget_set_text_align(widget, GUI_TEXT_ALIGN_CENTER|GUI_TEXT_ALIGN_MIDDLE|GUI_TEXT_OPAQUE);
 
         main_app_table[i].app_title_box = widget;
     }
@@ -91,18 +170,16 @@ window_t *gui_main_window_create(void)
 
 int16_t gui_main_page_app_install(char* title)
 {
-    if (current_app_install_cnt > 9) {
+    if (current_app_install_cnt >= 9) {
         return GUI_E_APP_FULL;
     }
 
     widget_t *widget;
-    char *icon_text = gui_strdup(title);
-    icon_text[1] = 0;
     widget = main_app_table[current_app_install_cnt].app_icon;
-    gui_widget_set_text(widget, icon_text);
+    gui_widget_set_image(widget, &gui_app_icons[current_app_install_cnt]);
 
     widget->flag |= GUI_WIDGET_FLAG_FILLED;
-    widget->gc.background = green;
+    widget->gc.background = black;
     widget->gc.foreground = white;
     widget->user_data = gui_app_self();
     GUI_WIDGET_ENABLE(widget);
@@ -133,13 +210,21 @@ void gui_main_page_app_uninstall(int16_t id)
 
     
     uint16_t i;
-    for ( i=id+1; i<=current_app_install_cnt; i++) {                                            /* shift all app icon forward           */
+
+    /* render task must not paint a title while its buffer changes hands */
+    gui_render_lock();
+
+    for ( i=id+1; i<current_app_install_cnt; i++) {                                            /* shift all app icon forward           */
         main_app_table[i-1].app_icon->flag      =  main_app_table[i].app_icon->flag;            /* copy useful data for icon widget     */
         main_app_table[i-1].app_icon->user_data =  main_app_table[i].app_icon->user_data;
         main_app_table[i-1].app_icon->gc        =  main_app_table[i].app_icon->gc;
         main_app_table[i-1].app_icon->text      =  main_app_table[i].app_icon->text;
+        main_app_table[i-1].app_icon->text_len  =  main_app_table[i].app_icon->text_len;
+        main_app_table[i-1].app_icon->text_cap  =  main_app_table[i].app_icon->text_cap;
 
-        main_app_table[i-1].app_title_box->text =  main_app_table[i].app_title_box->text;       /* copy useful data for title widget    */
+        main_app_table[i-1].app_title_box->text     =  main_app_table[i].app_title_box->text;   /* copy useful data for title widget    */
+        main_app_table[i-1].app_title_box->text_len =  main_app_table[i].app_title_box->text_len;
+        main_app_table[i-1].app_title_box->text_cap =  main_app_table[i].app_title_box->text_cap;
         main_app_table[i-1].app_title_box->flag =  main_app_table[i].app_title_box->flag;
         
         if (main_app_table[i-1].app_icon->user_data) {                                          /* update window id if need             */
@@ -149,55 +234,105 @@ void gui_main_page_app_uninstall(int16_t id)
     }
 
     --current_app_install_cnt;
-}
 
-static widget_t *gui_window_inverse_widgets_list(window_t *top)
-{
-    widget_t *inverse_list = top->widget_list; 
-    widget_t *tmp_list = top->widget_list,*tmp_node = Co_NULL;
+    /* picture belongs to slot, the one left empty has none */
+    main_app_table[current_app_install_cnt].app_icon->image = Co_NULL;
 
-    while (tmp_list->next != Co_NULL) {
-        inverse_list = tmp_list->next;
-        tmp_list->next = tmp_node;
-        tmp_node = tmp_list;
-        tmp_list = inverse_list;
-    }
-    inverse_list-> next = tmp_node;
+    /* text buffers were moved to the slot before, last one owns nothing now */
+    widget = main_app_table[current_app_install_cnt].app_icon;
+    widget->flag    &= ~GUI_WIDGET_FLAG_HAS_TEXT;
+    widget->text     = Co_NULL;
+    widget->text_len = 0;
+    widget->text_cap = 0;
 
-    top->widget_list = inverse_list;
+    widget = main_app_table[current_app_install_cnt].app_title_box;
+    widget->flag    &= ~GUI_WIDGET_FLAG_HAS_TEXT;
+    widget->text     = Co_NULL;
+    widget->text_len = 0;
+    widget->text_cap = 0;
 
-    return inverse_list;
+    gui_render_unlock();
 }
 
-widget_t *gui_window_get_mouse_event_widget(window_t *top, uint16_t cx, uint16_t cy)
+/**
+ *******************************************************************************
+ * @brief      Get next widget in painting order
+ * @param[in]  *widget          Current widget
+ * @param[in]  skip_children    Do not go into children of current widget
+ * @param[out] None
+ * @retval     *widget          Next widget to paint
+ * @retval     Co_NULL          Current widget is the last one
+ *
+ * @par Description
+ * @details    Container is painted before its children, and children are
+ *             painted before next widget of container.
+ *******************************************************************************
+ */
+static widget_t *_gui_window_next_widget(widget_t *widget, bool_t skip_children)
 {
-    ASSERT(top != Co_NULL);
+    if (!skip_children && widget->children != Co_NULL) {
+        return widget->children;
+    }
 
-    if (top != gui_get_current_window()) {
-        return Co_NULL;
+    while (widget != Co_NULL) {
+        if (widget->next != Co_NULL) {
+            return widget->next;
+        }
+
+        /* last child, go back to its container */
+        widget = widget->parent;
     }
 
-    widget_t *event_wgt = Co_NULL;
+    return Co_NULL;
+}
+
+static widget_t *_gui_window_find_mouse_widget(widget_t *list, uint16_t cx, uint16_t cy)
+{
+    widget_t *event_wgt = Co_NULL, *child_wgt;
 
-    gui_window_inverse_widgets_list(top);                         /* inverse widgets list to find event widget from top */
+    /* later widget is on top of earlier one, so the last one hit wins */
+    for (; list != Co_NULL; list = list->next) {
+        /* widgets under a header node never get mouse event */
+        if (list->flag & GUI_WIDGET_FLAG_HEADER) {
+            event_wgt = Co_NULL;
+            continue;
+        }
 
-    widget_t *tmp_list = top->widget_list;
-    while (!(tmp_list->flag & GUI_WIDGET_FLAG_HEADER)) {
-        if (!(tmp_list->flag & GUI_WIDGET_FLAG_SHOWN)) {
-            tmp_list=tmp_list->next;
+        if (!(list->flag & GUI_WIDGET_FLAG_SHOWN)) {
             continue;
         }
 
-        if ((cx >= tmp_list->extent.x1) && (cx <=tmp_list->extent.x2) &&
-            (cy >= tmp_list->extent.y1) && (cy <=tmp_list->extent.y2)) {
-            event_wgt = tmp_list;
-            break;
+        gui_widget_update_extent(list);
+        if ((cx < list->extent.x1) || (cx > list->extent.x2) ||
+            (cy < list->extent.y1) || (cy > list->extent.y2)) {
+            continue;       /* children are inside container, skip them too   */
+        }
+
+        event_wgt = list;
+
+        /* children are on top of their container */
+        child_wgt = _gui_window_find_mouse_widget(list->children, cx, cy);
+        if (child_wgt != Co_NULL) {
+            event_wgt = child_wgt;
         }
+    }
+
+    return event_wgt;
+}
 
-        tmp_list=tmp_list->next;
+widget_t *gui_window_get_mouse_event_widget(window_t *top, uint16_t cx, uint16_t cy)
+{
+    ASSERT(top != Co_NULL);
+
+    if (top != gui_get_current_window()) {
+        return Co_NULL;
+    }
+
+    if (!GUI_RECT_CONTAINS(&top->extent, cx, cy)) {
+        return Co_NULL;
     }
 
-    gui_window_inverse_widgets_list(top);                         /* inverse back to turn everythings back */
+    widget_t *event_wgt = _gui_window_find_mouse_widget(top->widget_list, cx, cy);
 
     if (top->focus_widget && top->focus_widget != event_wgt) {
         GUI_WIDGET_UNFOCUS(top->focus_widget);
@@ -210,203 +345,976 @@ widget_t *gui_window_get_mouse_event_widget(window_t *top, uint16_t cx, uint16_t
 
 /**
  *******************************************************************************
- * @brief      Refresh screen by list
- * @param[in]  None
+ * @brief      Fill widget around its text rectangle
+ * @param[in]  *widget  Which widget to fill
+ * @param[in]  *text    Text rectangle, filled by opaque text itself
  * @param[out] None
  * @retval     None
- *
- * @par Description
- * @details    This function is called to refresh screen by list.
  *******************************************************************************
  */
-StatusType gui_window_update(window_t *top, widget_t *widget)
+static void _gui_window_fill_around(widget_t *widget, rect_t *text)
 {
-    ASSERT(top != Co_NULL);
+    rect_t *inner = &widget->inner_extent;
+    rect_t  side[4];
+    int16_t i;
+
+    /* over, under, left and right of text */
+    GUI_SET_RECT(&side[0], inner->x1, inner->y1, GUI_RECT_WIDTH(inner), text->y1 - inner->y1);
+    GUI_SET_RECT(&side[1], inner->x1, text->y2, GUI_RECT_WIDTH(inner), inner->y2 - text->y2);
+    GUI_SET_RECT(&side[2], inner->x1, text->y1, text->x1 - inner->x1, GUI_RECT_HEIGHT(text));
+    GUI_SET_RECT(&side[3], text->x2, text->y1, inner->x2 - text->x2, GUI_RECT_HEIGHT(text));
+
+    for (i = 0; i < 4; i++) {
+        if (!GUI_RECT_IS_EMPTY(&side[i])) {
+            widget->dc_engine->engine->fill_rect(widget->dc_engine, &side[i]);
+        }
+    }
+}
+
+static void _gui_window_draw_widget(widget_t *widget)
+{
+    /* draw shape if needed */
+    if (widget->flag & GUI_WIDGET_FLAG_RECT) {
+        if ((widget->flag & GUI_WIDGET_FLAG_FILLED) &&
+            (widget->flag & GUI_WIDGET_FLAG_HAS_TEXT) && (widget->gc.text_align & GUI_TEXT_OPAQUE)) {
+            /* opaque text fills its own rectangle, each pixel is written once */
+            rect_t pr = widget->inner_extent;
+            uint64_t padding = widget->gc.padding;
+            GUI_RECT_PADDING(&pr, padding);
 
-    if (!GUI_WINDOW_IS_ENABLE(top) && top != main_page) {
-        top = main_page;
+            _gui_window_fill_around(widget, &pr);
+        }
+        else if (widget->flag & GUI_WIDGET_FLAG_FILLED) {
+            widget->dc_engine->engine->fill_rect(widget->dc_engine, &widget->inner_extent);
+        }
+        else {
+            gui_dc_draw_rect(widget->dc_engine, &widget->inner_extent);
+        }
     }
 
-    if (!GUI_WINDOW_IS_ENABLE(top) && top == main_page) {
-        return GUI_E_ERROR;
+    /* draw picture in middle if needed */
+    if (widget->image != Co_NULL) {
+        rect_t *inner = &widget->inner_extent;
+
+        gui_dc_draw_image(widget->dc_engine,
+                          inner->x1 + (GUI_RECT_WIDTH(inner) - widget->image->width) / 2,
+                          inner->y1 + (GUI_RECT_HEIGHT(inner) - widget->image->height) / 2,
+                          widget->image);
     }
 
-    widget_t *list = top->widget_list->next;
+    /* draw text if needed */
+    if (widget->flag & GUI_WIDGET_FLAG_HAS_TEXT) {
+        rect_t pr = widget->inner_extent;
+        uint64_t padding = widget->gc.padding;
+        GUI_RECT_PADDING(&pr, padding);
 
-    while (list != widget && widget!= Co_NULL) {
-        list = list->next;
+        gui_dc_draw_text(widget->dc_engine, &pr, widget->text);
     }
 
-    while (list != Co_NULL) {
-        /* if this node is disabled, skip it */
-        if (!COGUI_WIDGET_IS_ENABLE(list)){
-            list = list->next;
+    /* draw border at last if needed */
+    if (widget->flag & GUI_WIDGET_BORDER) {
+        gui_dc_draw_border(widget->dc_engine, &widget->inner_extent);
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Paint the visible part of a widget
+ * @param[in]  *widget  Which widget to paint
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    This function is called to cut off the parts of widget covered
+ *             by opaque widgets above it, then paint the widget once for each
+ *             rectangle left. Widget fully covered is skipped.
+ *******************************************************************************
+ */
+static void _gui_window_paint_widget(widget_t *widget, rect_t *damage)
+{
+    region_t visible;
+    widget_t *above;
+    rect_t   rect, bound;
+    int16_t  i;
+
+    /* only the part on damaged area is needed */
+    if (!gui_widget_get_clip_extent(widget, &bound) || !gui_rect_intersect(&bound, damage, &bound)) {
+        return;
+    }
+    gui_region_init(&visible, &bound);
+
+    /* its children and widgets after it are painted on top of it */
+    above = _gui_window_next_widget(widget, 0);
+    while (above != Co_NULL) {
+        gui_widget_update_extent(above);
+
+        /* hidden or far away container, so are its children */
+        if (!(above->flag & GUI_WIDGET_FLAG_SHOWN) || !gui_rect_is_intersect(&above->extent, &bound)) {
+            above = _gui_window_next_widget(above, 1);
             continue;
         }
 
-        /* draw shape if needed */
-        if (list->flag & GUI_WIDGET_FLAG_RECT) {
-            if (list->flag & GUI_WIDGET_FLAG_FILLED) {
-                list->dc_engine->engine->fill_rect(list->dc_engine, &list->inner_extent);
-			}
-            else {
-                gui_dc_draw_rect(list->dc_engine, &list->inner_extent);
+        if (GUI_WIDGET_IS_OPAQUE(above) && gui_widget_get_clip_extent(above, &rect)) {
+            gui_region_subtract_rect(&visible, &rect);
+            if (gui_region_is_empty(&visible)) {
+                return;
             }
         }
-        
-        /* draw text if needed */
-        if (list->flag & GUI_WIDGET_FLAG_HAS_TEXT) {
-            rect_t pr = list->inner_extent;
-            uint64_t padding = list->gc.padding;
-            GUI_RECT_PADDING(&pr, padding);
 
-            gui_dc_draw_text(list->dc_engine, &pr, list->text);
-        }
+        above = _gui_window_next_widget(above, 0);
+    }
 
-        /* draw border at last if needed */
-        if (list->flag & GUI_WIDGET_BORDER) {
-            gui_dc_draw_border(list->dc_engine, &list->inner_extent);
-        }        
+    for (i = 0; i < visible.count; i++) {
+        gui_dc_set_clip(widget->dc_engine, &visible.rects[i]);
 
-        /* go forward to next node */
-        list = list->next;
+        /* widget with its own drawing paints only the given part */
+        if (widget->on_draw != Co_NULL) {
+            widget->on_draw(widget, &visible.rects[i]);
+        }
+        else {
+            _gui_window_draw_widget(widget);
+        }
     }
 
-    return GUI_E_OK;
-}
-
-StatusType gui_window_refresh(window_t *top) {
-    return gui_window_update(top, Co_NULL);
+    gui_dc_set_clip(widget->dc_engine, Co_NULL);
 }
 
-void gui_window_delete(window_t *win)
+/**
+ *******************************************************************************
+ * @brief      Paint widgets of window on a rectangle
+ * @param[in]  *top     Which window to paint
+ * @param[in]  *damage  Physical area to paint
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    This function is called to refresh screen by list. Only the
+ *             parts of widgets inside damaged area and not covered by opaque
+ *             widgets are painted.
+ *******************************************************************************
+ */
+static void _gui_window_paint_rect(window_t *top, rect_t *damage)
 {
-    /* remove magic code */
-    win->magic = 0;
-
-    /* delete title widget */
-    //gui_title_delete(win);
-    //gui_widget_delete(win->title);
+    widget_t *list = top->widget_list->next;
 
-    /* delete all widget */
-    widget_t *tmp_widget = win->widget_list->next;
-    widget_t *next_delete_widget = tmp_widget->next;
-    while (next_delete_widget != Co_NULL) {
-        gui_widget_delete(tmp_widget);
-        tmp_widget = next_delete_widget;
-        next_delete_widget = next_delete_widget->next;
-    }
+    while (list != Co_NULL) {
+        gui_widget_update_extent(list);
 
-    /* last delete header widget */
-    //gui_widget_delete(win->widget_list);
+        /* if this node is disabled or out of damaged area, skip its children too */
+        if (!COGUI_WIDGET_IS_ENABLE(list) || !gui_rect_is_intersect(&list->extent, damage)) {
+            list = _gui_window_next_widget(list, 1);
+            continue;
+        }
 
-    /* remove window pointer in app structure */
-    win->app->win = Co_NULL;
+        _gui_window_paint_widget(list, damage);
 
-    /* free user data if need */
-    if (win->user_data) {
-        gui_free(win->user_data);
+        /* go forward to next node */
+        list = _gui_window_next_widget(list, 0);
     }
-
-    gui_main_page_app_uninstall(win->id);
-
-    /* free window */
-    gui_free(win);
 }
 
-StatusType gui_window_close(window_t *win)
+/**
+ *******************************************************************************
+ * @brief      Call a function on every part of a rectangle not covered
+ * @param[in]  *win     Window the rectangle belongs to
+ * @param[in]  *above   First window that may cover it
+ * @param[in]  *rect    Physical rectangle
+ * @param[in]  visit    Function called with window and each visible part
+ * @param[in]  *arg     Passed to visit
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Rectangle is cut by one window at a time and only the pieces
+ *             left go on to the next one, nothing is stored. So the parts
+ *             are exact however many windows overlap, unlike a region which
+ *             keeps a rectangle whole when it runs out of room.
+ *******************************************************************************
+ */
+static void _gui_window_visit_visible(window_t *win, window_t *above, rect_t *rect,
+                                      void (*visit)(window_t *win, rect_t *rect, void *arg), void *arg)
 {
-    ASSERT(win != Co_NULL);
+    rect_t  piece[4];
+    int16_t i, n;
 
-    gui_window_delete(win);
+    while (above != Co_NULL && !gui_rect_is_intersect(&above->extent, rect)) {
+        above = above->above;
+    }
 
-    event_t event;
-    EVENT_INIT(&event, EVENT_WINDOW_CLOSE);
-    event.win = win;
+    if (above == Co_NULL) {
+        visit(win, rect, arg);
+        return;
+    }
 
-    return gui_send(gui_get_server(), &event);
+    n = gui_rect_subtract(rect, &above->extent, piece);
+    for (i = 0; i < n; i++) {
+        _gui_window_visit_visible(win, above->above, &piece[i], visit, arg);
+    }
 }
 
-void gui_window_set_onactivate(window_t *win, event_handler_ptr handler)
+/**
+ *******************************************************************************
+ * @brief      Put a visible part of window on screen
+ * @param[in]  *top     Which window
+ * @param[in]  *rect    Physical part not covered by upper windows
+ * @param[in]  *arg     Not used
+ * @param[out] None
+ * @retval     None
+ *******************************************************************************
+ */
+static void _gui_window_show_part(window_t *top, rect_t *rect, void *arg)
 {
-    ASSERT(win != Co_NULL);
-    
-    win->on_activate = handler;
+    if (top->store != Co_NULL) {
+        gui_framebuffer_blit(gui_graphic_driver_get_default(), top->store, rect);
+    }
+    else {
+        _gui_window_paint_rect(top, rect);
+    }
 }
 
-void gui_window_set_ondeactive(window_t *win, event_handler_ptr handler)
+/**
+ *******************************************************************************
+ * @brief      Paint damaged area of window
+ * @param[in]  *top     Which window to paint
+ * @param[in]  *damage  Physical area to paint
+ * @param[out] None
+ * @retval     GUI_E_OK     Painting finished
+ * @retval     GUI_E_ERROR  Nothing is shown
+ *
+ * @par Description
+ * @details    Window with backing store is painted into its store, then the
+ *             visible part is copied to screen. Other windows are painted on
+ *             screen, only the parts not covered by upper windows.
+ *******************************************************************************
+ */
+static StatusType _gui_window_paint(window_t *top, rect_t *damage)
 {
-    ASSERT(win != Co_NULL);
-    
-    win->on_deactivate = handler;
-}
+    graphic_driver_t *screen;
+    rect_t   area;
 
+    if (!gui_rect_intersect(damage, &top->extent, &area)) {
+        return GUI_E_OK;
+    }
 
-void gui_window_set_onkey(window_t *win, event_handler_ptr handler)
-{
-    ASSERT(win != Co_NULL);
-    
-    win->on_key = handler;
-}
+    if (top->store != Co_NULL) {
+        screen = gui_graphic_driver_get_default();
 
-StatusType gui_window_show(window_t *win)
-{
-    ASSERT(win != Co_NULL);
-    event_t event;
-    StatusType result;
+        gui_set_graphic_driver(top->store);
+        _gui_window_paint_rect(top, &area);
+        gui_set_graphic_driver(screen);
 
-    /* if this is not main page to show, first hide main page */
-    if (win != main_page) {
-        GUI_WINDOW_DISABLE(main_page);
+        if (gui_memcmp(&area, &top->extent, sizeof(rect_t)) == 0) {
+            top->store_valid = 1;
+        }
     }
 
-    /* determine whether if window is need to show */
-    if (GUI_WINDOW_IS_ENABLE(win)) {
+    if (!GUI_WINDOW_IS_ENABLE(top)) {
         return GUI_E_ERROR;
     }
-    else {
-        GUI_WINDOW_ENABLE(win);
-    }
 
-    EVENT_INIT(&event, EVENT_WINDOW_SHOW);
-
-    if (win->handler != Co_NULL)
-        result = win->handler(win, &event);
+    /* upper windows cover it */
+    _gui_window_visit_visible(top, top->above, &area, _gui_window_show_part, Co_NULL);
 
-    return result;
+    return GUI_E_OK;
 }
 
-StatusType gui_window_hide(window_t *win)
+/**
+ *******************************************************************************
+ * @brief      Recomposite a part of screen owned by a window
+ * @param[in]  *win     Window on top at this part
+ * @param[in]  *rect    Physical part
+ * @param[in]  *painted Area copied to screen is added to it
+ * @param[out] None
+ * @retval     None
+ *******************************************************************************
+ */
+static void _gui_window_expose_part(window_t *win, rect_t *rect, void *painted)
 {
-    ASSERT(win != Co_NULL);
-    event_t event;
-    StatusType result;
-
-    /* determine whether if window is need to hide */
-    if (!GUI_WINDOW_IS_ENABLE(win)) {
-        return GUI_E_ERROR;
+    if (win->store != Co_NULL && win->store_valid) {
+        gui_framebuffer_blit(gui_graphic_driver_get_default(), win->store, rect);
+        gui_rect_union(painted, rect, painted);
     }
     else {
-        GUI_WINDOW_DISABLE(win);
+        gui_region_add_rect(&win->dirty, rect);
     }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Recomposite screen area uncovered by windows
+ * @param[in]  *area    Physical area exposed
+ * @param[out] *painted Area copied to screen is added to it
+ * @retval     None
+ *
+ * @par Description
+ * @details    Windows are walked from top to bottom. The part of area each
+ *             window owns is copied from its backing store, or marked damaged
+ *             if window has no valid store, so widgets are painted only then.
+ *******************************************************************************
+ */
+static void _gui_window_expose(rect_t *area, rect_t *painted)
+{
+    window_t *win;
+    rect_t   rect;
+
+    for (win = _gui_window_stack_top(); win != Co_NULL; win = win->below) {
+        if (gui_rect_intersect(area, &win->extent, &rect)) {
+            _gui_window_visit_visible(win, win->above, &rect, _gui_window_expose_part, painted);
+        }
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Give up pending scroll of window
+ * @param[in]  *top     Which window scrolled
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Scrolled widget is repainted all over again instead of moving
+ *             its pixels.
+ *******************************************************************************
+ */
+static void _gui_window_drop_scroll(window_t *top)
+{
+    rect_t view;
+
+    if (top->scroll_widget == Co_NULL) {
+        return;
+    }
+
+    if (gui_widget_get_clip_extent(top->scroll_widget, &view)) {
+        gui_region_add_rect(&top->dirty, &view);
+    }
+
+    top->scroll_widget  = Co_NULL;
+    top->scroll_delta.x = 0;
+    top->scroll_delta.y = 0;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Determine whether pixels of a widget can be moved
+ * @param[in]  *top     Which window scrolled
+ * @param[in]  *view    Widget scrolled
+ * @param[in]  *bound   Visible physical area of widget
+ * @param[out] None
+ * @retval     1        Only the widget and its children are drawn on bound
+ * @retval     0        Something else is on top of it
+ *******************************************************************************
+ */
+static bool_t _gui_window_can_copy(window_t *top, widget_t *view, rect_t *bound)
+{
+    widget_t *above;
+    window_t *win;
+    rect_t   rect;
+
+    /* its container would be moved along if it is not opaque */
+    if (!GUI_WIDGET_IS_OPAQUE(view)) {
+        return 0;
+    }
+
+    if (GUI_WINDOW_IS_ENABLE(top)) {
+        for (win = top->above; win != Co_NULL; win = win->above) {
+            if (gui_rect_is_intersect(&win->extent, bound)) {
+                return 0;
+            }
+        }
+    }
+
+    /* widgets after it are painted on top of it */
+    above = _gui_window_next_widget(view, 1);
+    while (above != Co_NULL) {
+        gui_widget_update_extent(above);
+
+        if (!(above->flag & GUI_WIDGET_FLAG_SHOWN)) {
+            above = _gui_window_next_widget(above, 1);
+            continue;
+        }
+
+        if (gui_widget_get_clip_extent(above, &rect) && gui_rect_is_intersect(&rect, bound)) {
+            return 0;
+        }
+
+        above = _gui_window_next_widget(above, 0);
+    }
+
+    return 1;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Move pixels of pending scroll
+ * @param[in]  *top     Which window scrolled
+ * @param[out] *painted Area changed on screen is added to it, can be Co_NULL
+ * @retval     None
+ *
+ * @par Description
+ * @details    Pixels still valid after scrolling are copied to their new
+ *             place, on screen and in backing store, so only the strips
+ *             uncovered are marked damaged. Widget covered by others, or
+ *             scrolled further than its size, is repainted all over again.
+ *******************************************************************************
+ */
+static void _gui_window_apply_scroll(window_t *top, rect_t *painted)
+{
+    graphic_driver_t *screen;
+    widget_t *view = top->scroll_widget;
+    int32_t  dx = top->scroll_delta.x;
+    int32_t  dy = top->scroll_delta.y;
+    rect_t   bound, rect, strip;
+
+    if (view == Co_NULL || !gui_widget_get_clip_extent(view, &bound)) {
+        top->scroll_widget = Co_NULL;
+        return;
+    }
+
+    if (ABS(dx) >= GUI_RECT_WIDTH(&bound) || ABS(dy) >= GUI_RECT_HEIGHT(&bound) ||
+        !_gui_window_can_copy(top, view, &bound)) {
+        _gui_window_drop_scroll(top);
+        return;
+    }
+
+    top->scroll_widget  = Co_NULL;
+    top->scroll_delta.x = 0;
+    top->scroll_delta.y = 0;
+
+    /* whole widget in logic coordinate, cut by clip */
+    GUI_SET_RECT(&rect, 0, 0, GUI_RECT_WIDTH(&view->extent), GUI_RECT_HEIGHT(&view->extent));
+    gui_dc_set_clip(view->dc_engine, &bound);
+
+    if (top->store != Co_NULL) {
+        screen = gui_graphic_driver_get_default();
+
+        gui_set_graphic_driver(top->store);
+        gui_dc_copy_area(view->dc_engine, &rect, dx, dy);
+        gui_set_graphic_driver(screen);
+    }
+
+    if (GUI_WINDOW_IS_ENABLE(top)) {
+        gui_dc_copy_area(view->dc_engine, &rect, dx, dy);
+
+        if (painted != Co_NULL) {
+            gui_rect_union(painted, &bound, painted);
+        }
+    }
+
+    gui_dc_set_clip(view->dc_engine, Co_NULL);
+
+    /* strips uncovered by the move are painted by widgets */
+    if (dy != 0) {
+        strip = bound;
+        if (dy > 0) {
+            strip.y2 = bound.y1 + dy;
+        }
+        else {
+            strip.y1 = bound.y2 + dy;
+        }
+        gui_region_add_rect(&top->dirty, &strip);
+    }
+
+    if (dx != 0) {
+        strip = bound;
+        if (dx > 0) {
+            strip.x2 = bound.x1 + dx;
+        }
+        else {
+            strip.x1 = bound.x2 + dx;
+        }
+        gui_region_add_rect(&top->dirty, &strip);
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief      Paint damaged area recorded on window
+ * @param[in]  *top     Which window to paint
+ * @param[out] *painted Painted area is added to it, can be Co_NULL
+ * @retval     GUI_E_OK     Damaged area is repainted, or nothing to paint
+ * @retval     GUI_E_ERROR  Nothing is shown
+ *
+ * @par Description
+ * @details    Window in an update transaction is left for the next frame.
+ *******************************************************************************
+ */
+StatusType gui_window_flush(window_t *top, rect_t *painted)
+{
+    rect_t damage;
+    StatusType result = GUI_E_OK;
+
+    ASSERT(top != Co_NULL);
+
+    if (top->update > 0) {
+        return GUI_E_OK;
+    }
+
+    /* move scrolled pixels first, damaged area may grow by the strips */
+    _gui_window_apply_scroll(top, painted);
+
+    /* every damaged rectangle is painted on its own, gaps are left alone */
+    while (!gui_region_is_empty(&top->dirty)) {
+        damage = top->dirty.rects[--top->dirty.count];
+
+        if (_gui_window_paint(top, &damage) != GUI_E_OK) {
+            result = GUI_E_ERROR;
+        }
+        else if (painted != Co_NULL) {
+            gui_rect_union(painted, &damage, painted);
+        }
+    }
+
+    return result;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Compose a frame from all windows on screen
+ * @param[in]  None
+ * @param[out] *painted Area changed on screen is added to it
+ * @retval     GUI_E_OK     Frame is composed
+ *
+ * @par Description
+ * @details    This function is called by render task once a frame. Exposed
+ *             area is recomposited first, then damaged area of every window.
+ *******************************************************************************
+ */
+StatusType gui_window_flush_all(rect_t *painted)
+{
+    window_t *win;
+    rect_t   area;
+
+    ASSERT(painted != Co_NULL);
+
+    if (!GUI_RECT_IS_EMPTY(&window_exposed)) {
+        area = window_exposed;
+        GUI_INIT_RECT(&window_exposed);
+        _gui_window_expose(&area, painted);
+    }
+
+    for (win = window_stack; win != Co_NULL; win = win->above) {
+        gui_window_flush(win, painted);
+    }
+
+    return GUI_E_OK;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Compose next frame
+ * @param[in]  None
+ * @param[out] None
+ * @retval     GUI_E_OK     Frame is composed or scheduled
+ *******************************************************************************
+ */
+static StatusType _gui_window_schedule(void)
+{
+    graphic_driver_t *driver;
+    StatusType result;
+    rect_t painted;
+
+    /* paint in next frame, or right now if there is no render task */
+    if (gui_render_request() == GUI_E_OK) {
+        return GUI_E_OK;
+    }
+
+    driver = gui_graphic_driver_get_default();
+    GUI_INIT_RECT(&painted);
+
+    gui_graphic_driver_begin_frame(driver);
+    result = gui_window_flush_all(&painted);
+    gui_graphic_driver_end_frame(driver, &painted);
+
+    return result;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Hand damaged area of window over for painting
+ * @param[in]  *top     Which window is damaged
+ * @param[out] None
+ * @retval     GUI_E_OK     Area is repainted or scheduled
+ *******************************************************************************
+ */
+static StatusType _gui_window_commit(window_t *top)
+{
+    if (gui_region_is_empty(&top->dirty) && top->scroll_widget == Co_NULL) {
+        return GUI_E_OK;
+    }
+
+    if (!GUI_WINDOW_IS_ENABLE(top)) {
+        /* painted into backing store when shown, or all over again */
+        if (top->store == Co_NULL) {
+            gui_region_init(&top->dirty, Co_NULL);
+            top->scroll_widget = Co_NULL;
+            top->scroll_delta.x = 0;
+            top->scroll_delta.y = 0;
+        }
+        return GUI_E_OK;
+    }
+
+    return _gui_window_schedule();
+}
+
+/**
+ *******************************************************************************
+ * @brief      Recomposite screen area uncovered by a window
+ * @param[in]  *area    Physical area exposed
+ * @param[out] None
+ * @retval     GUI_E_OK     Area is recomposited or scheduled
+ *******************************************************************************
+ */
+static StatusType _gui_window_uncover(rect_t *area)
+{
+    gui_rect_union(&window_exposed, area, &window_exposed);
+
+    return _gui_window_schedule();
+}
+
+/**
+ *******************************************************************************
+ * @brief      Mark an area of window damaged
+ * @param[in]  *top     Which window is damaged
+ * @param[in]  *rect    Physical damaged area, Co_NULL for full screen
+ * @param[out] None
+ * @retval     GUI_E_OK     Area is repainted or recorded
+ * @retval     GUI_E_ERROR  Nothing is shown
+ *
+ * @par Description
+ * @details    This function is called to record an area of window to repaint.
+ *             It is painted in next frame by render task, or right now if
+ *             frame scheduler is disabled. Inside gui_window_begin_update and
+ *             gui_window_end_update, all changes wait for the end.
+ *******************************************************************************
+ */
+StatusType gui_window_invalidate(window_t *top, rect_t *rect)
+{
+    rect_t damage;
+    StatusType result = GUI_E_OK;
+
+    ASSERT(top != Co_NULL);
+
+    GUI_SET_RECT(&damage, 0, 0, COGUI_SCREEN_WIDTH, COGUI_SCREEN_HEIGHT);
+    if (rect != Co_NULL && !gui_rect_intersect(rect, &damage, &damage)) {
+        return GUI_E_OK;
+    }
+
+    gui_render_lock();
+
+    gui_region_add_rect(&top->dirty, &damage);
+
+    /* in update transaction, paint it when transaction finished */
+    if (top->update == 0) {
+        result = _gui_window_commit(top);
+    }
+
+    gui_render_unlock();
+
+    return result;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Scroll content of a widget
+ * @param[in]  *top     Which window the widget belongs to
+ * @param[in]  *widget  Widget whose content moved
+ * @param[in]  dx       Pixels content moved on x axis
+ * @param[in]  dy       Pixels content moved on y axis
+ * @param[out] None
+ * @retval     GUI_E_OK     Scroll is applied or recorded
+ * @retval     GUI_E_ERROR  Nothing is shown
+ *
+ * @par Description
+ * @details    This function is called after the content offset of a widget is
+ *             changed. Pixels on screen are moved in next frame and only the
+ *             uncovered strips are repainted. Scrolls of one widget before a
+ *             frame are added up, scrolling another widget in the same frame
+ *             repaints the first one.
+ *******************************************************************************
+ */
+StatusType gui_window_scroll(window_t *top, widget_t *widget, int32_t dx, int32_t dy)
+{
+    region_t moved;
+    rect_t   view, rect;
+    int16_t  i;
+    StatusType result = GUI_E_OK;
+
+    ASSERT(top != Co_NULL);
+    ASSERT(widget != Co_NULL);
+
+    if (dx == 0 && dy == 0) {
+        return GUI_E_OK;
+    }
+
+    gui_render_lock();
+
+    if (top->scroll_widget != Co_NULL && top->scroll_widget != widget) {
+        _gui_window_drop_scroll(top);
+    }
+
+    if (gui_widget_get_clip_extent(widget, &view)) {
+        /* damaged pixels inside are moved along */
+        gui_region_init(&moved, Co_NULL);
+        for (i = 0; i < top->dirty.count; i++) {
+            if (gui_rect_intersect(&top->dirty.rects[i], &view, &rect)) {
+                rect.x1 += dx;
+                rect.x2 += dx;
+                rect.y1 += dy;
+                rect.y2 += dy;
+                if (gui_rect_intersect(&rect, &view, &rect)) {
+                    gui_region_add_rect(&moved, &rect);
+                }
+            }
+        }
+
+        for (i = 0; i < moved.count; i++) {
+            gui_region_add_rect(&top->dirty, &moved.rects[i]);
+        }
+
+        top->scroll_widget   = widget;
+        top->scroll_delta.x += dx;
+        top->scroll_delta.y += dy;
+    }
+
+    if (top->update == 0) {
+        result = _gui_window_commit(top);
+    }
+
+    gui_render_unlock();
+
+    return result;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Start an update transaction of window
+ * @param[in]  *top     Which window to update
+ * @param[out] None
+ * @retval     None
+ *
+ * @par Description
+ * @details    Repaint requests after this call are collected until the
+ *             matched gui_window_end_update is called. Calls can be nested.
+ *******************************************************************************
+ */
+void gui_window_begin_update(window_t *top)
+{
+    ASSERT(top != Co_NULL);
+
+    /* render task does not paint half changed widgets */
+    gui_render_lock();
+
+    top->update++;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Finish an update transaction of window
+ * @param[in]  *top     Which window to update
+ * @param[out] None
+ * @retval     GUI_E_OK     Damaged area is repainted, or still in transaction
+ * @retval     GUI_E_ERROR  Nothing is shown
+ *
+ * @par Description
+ * @details    When the outermost transaction finished, all damaged area is
+ *             painted once, in next frame if frame scheduler is enabled.
+ *             Damage far apart is kept as separate rectangles, so the space
+ *             between them is not repainted.
+ *******************************************************************************
+ */
+StatusType gui_window_end_update(window_t *top)
+{
+    StatusType result = GUI_E_OK;
+
+    ASSERT(top != Co_NULL);
+    ASSERT(top->update > 0);
+
+    if (--top->update == 0) {
+        result = _gui_window_commit(top);
+    }
+
+    gui_render_unlock();
+
+    return result;
+}
+
+StatusType gui_window_update(window_t *top, widget_t *widget)
+{
+    rect_t rect;
+
+    ASSERT(top != Co_NULL);
+
+    /* repaint area of given widget, or the whole window */
+    if (widget == Co_NULL) {
+        return gui_window_invalidate(top, Co_NULL);
+    }
+
+    if (!gui_widget_get_clip_extent(widget, &rect)) {
+        return GUI_E_OK;
+    }
+
+    return gui_window_invalidate(top, &rect);
+}
+
+StatusType gui_window_refresh(window_t *top) {
+    return gui_window_invalidate(top, Co_NULL);
+}
+
+void gui_window_delete(window_t *win)
+{
+    /* render task must not walk widgets being freed */
+    gui_render_lock();
+
+    /* take it off screen first, windows under it are recomposited */
+    if (GUI_WINDOW_IS_ENABLE(win)) {
+        GUI_WINDOW_DISABLE(win);
+        _gui_window_stack_remove(win);
+        _gui_window_uncover(&win->extent);
+    }
+
+    /* remove magic code */
+    win->magic = 0;
+
+    /* delete title widget */
+    //gui_title_delete(win);
+    //gui_widget_delete(win->title);
+
+    /* delete all widget */
+    widget_t *tmp_widget = win->widget_list->next;
+    widget_t *next_delete_widget = tmp_widget->next;
+    while (next_delete_widget != Co_NULL) {
+        gui_widget_delete(tmp_widget);
+        tmp_widget = next_delete_widget;
+        next_delete_widget = next_delete_widget->next;
+    }
+
+    /* last delete header widget */
+    //gui_widget_delete(win->widget_list);
+
+    /* remove window pointer in app structure */
+    win->app->win = Co_NULL;
+
+    /* free user data if need */
+    if (win->user_data) {
+        gui_free(win->user_data);
+    }
+
+    gui_main_page_app_uninstall(win->id);
+
+    if (win->store != Co_NULL) {
+        gui_free(win->store);
+    }
+
+    /* free window */
+    gui_free(win);
+
+    gui_render_unlock();
+}
+
+StatusType gui_window_close(window_t *win)
+{
+    ASSERT(win != Co_NULL);
+
+    gui_window_delete(win);
+
+    event_t event;
+    EVENT_INIT(&event, EVENT_WINDOW_CLOSE);
+    event.win = win;
+
+    return gui_send(gui_get_server(), &event);
+}
+
+void gui_window_set_onactivate(window_t *win, event_handler_ptr handler)
+{
+    ASSERT(win != Co_NULL);
+    
+    win->on_activate = handler;
+}
+
+void gui_window_set_ondeactive(window_t *win, event_handler_ptr handler)
+{
+    ASSERT(win != Co_NULL);
+    
+    win->on_deactivate = handler;
+}
+
+
+void gui_window_set_onkey(window_t *win, event_handler_ptr handler)
+{
+    ASSERT(win != Co_NULL);
+    
+    win->on_key = handler;
+}
+
+StatusType gui_window_show(window_t *win)
+{
+    ASSERT(win != Co_NULL);
+    event_t event;
+    StatusType result;
+
+    /* window already shown is raised to top */
+    if (GUI_WINDOW_IS_ENABLE(win)) {
+        if (win == _gui_window_stack_top()) {
+            return GUI_E_ERROR;
+        }
+
+        gui_render_lock();
+        _gui_window_stack_remove(win);
+        _gui_window_stack_push(win);
+        result = _gui_window_uncover(&win->extent);
+        gui_render_unlock();
+
+        return result;
+    }
+
+    gui_render_lock();
+    GUI_WINDOW_ENABLE(win);
+    _gui_window_stack_push(win);
+    gui_render_unlock();
+
+    EVENT_INIT(&event, EVENT_WINDOW_SHOW);
 
-    EVENT_INIT(&event, EVENT_WINDOW_HIDE);
-
     if (win->handler != Co_NULL)
         result = win->handler(win, &event);
 
     return result;
 }
 
-StatusType gui_window_onshow(window_t *win)
+StatusType gui_window_hide(window_t *win)
 {
+    ASSERT(win != Co_NULL);
+    event_t event;
+    StatusType result;
+
+    /* determine whether if window is need to hide */
     if (!GUI_WINDOW_IS_ENABLE(win)) {
         return GUI_E_ERROR;
     }
 
-	gui_window_refresh(win);
+    gui_render_lock();
+    GUI_WINDOW_DISABLE(win);
+    _gui_window_stack_remove(win);
+    _gui_window_uncover(&win->extent);
+    gui_render_unlock();
 
-    current_window = win;
+    EVENT_INIT(&event, EVENT_WINDOW_HIDE);
+
+    if (win->handler != Co_NULL)
+        result = win->handler(win, &event);
+
+    return result;
+}
+
+StatusType gui_window_onshow(window_t *win)
+{
+    if (!GUI_WINDOW_IS_ENABLE(win)) {
+        return GUI_E_ERROR;
+    }
+
+    /* copied from backing store if it is up to date, or painted */
+    gui_render_lock();
+    _gui_window_uncover(&win->extent);
+    gui_render_unlock();
 
     return GUI_E_OK;
 }
@@ -428,6 +1336,133 @@ StatusType gui_window_onhide(window_t *win)
     return gui_send(gui_get_server(), &event);
 }
 
+/**
+ *******************************************************************************
+ * @brief      Move or resize a window
+ * @param[in]  *win     Which window to set
+ * @param[in]  *rect    New physical area of window
+ * @param[out] None
+ * @retval     GUI_E_OK     Window is set
+ * @retval     GUI_E_ERROR  Area is empty, or no memory for backing store
+ *
+ * @par Description
+ * @details    Widgets of window are placed relative to window position. If
+ *             window is shown, the old area is recomposited from windows
+ *             under it and the new area from the window itself.
+ *******************************************************************************
+ */
+StatusType gui_window_set_extent(window_t *win, rect_t *rect)
+{
+    StatusType result = GUI_E_OK;
+    rect_t old;
+
+    ASSERT(win != Co_NULL);
+    ASSERT(rect != Co_NULL);
+
+    if (GUI_RECT_IS_EMPTY(rect)) {
+        return GUI_E_ERROR;
+    }
+
+    gui_render_lock();
+
+    old = win->extent;
+    win->extent = *rect;
+
+    /* backing store keeps its pixels if only moved */
+    if (win->store != Co_NULL) {
+        if (GUI_RECT_WIDTH(&old) == GUI_RECT_WIDTH(rect) && GUI_RECT_HEIGHT(&old) == GUI_RECT_HEIGHT(rect)) {
+            _gui_window_locate_store(win);
+        }
+        else {
+            gui_window_set_backing_store(win, 0);
+            result = gui_window_set_backing_store(win, 1);
+        }
+    }
+
+    if (GUI_WINDOW_IS_ENABLE(win)) {
+        gui_rect_union(&window_exposed, &old, &window_exposed);
+        _gui_window_uncover(&win->extent);
+    }
+
+    gui_render_unlock();
+
+    return result;
+}
+
+/**
+ *******************************************************************************
+ * @brief      Give window an offscreen backing store
+ * @param[in]  *win     Which window to set
+ * @param[in]  enable   1 to allocate store, 0 to free it
+ * @param[out] None
+ * @retval     GUI_E_OK     Store is set
+ * @retval     GUI_E_ERROR  No memory for backing store
+ *
+ * @par Description
+ * @details    Widgets of window with backing store are painted into the
+ *             store, and raising, hiding or closing windows above it only
+ *             copies the stored pixels to screen. Store has pixel format
+ *             of screen, 2 or 4 bytes for each pixel of window.
+ *******************************************************************************
+ */
+StatusType gui_window_set_backing_store(window_t *win, bool_t enable)
+{
+    graphic_driver_t *store, *screen;
+    uint16_t w, h;
+    uint8_t  format;
+
+    ASSERT(win != Co_NULL);
+
+    gui_render_lock();
+
+    if (!enable) {
+        if (win->store != Co_NULL) {
+            gui_free(win->store);
+            win->store = Co_NULL;
+            win->store_valid = 0;
+        }
+        gui_render_unlock();
+        return GUI_E_OK;
+    }
+
+    if (win->store != Co_NULL) {
+        gui_render_unlock();
+        return GUI_E_OK;
+    }
+
+    screen = gui_graphic_driver_get_default();
+    format = screen->pixel_format == GRAPHIC_PIXEL_FORMAT_ARGB888 ?
+             GRAPHIC_PIXEL_FORMAT_ARGB888 : GRAPHIC_PIXEL_FORMAT_RGB565;
+
+    /* pixels are put right after driver struct */
+    w = GUI_RECT_WIDTH(&win->extent);
+    h = GUI_RECT_HEIGHT(&win->extent);
+    store = gui_malloc(sizeof(graphic_driver_t) + (uint32_t)w * h * GUI_FB_BPP(screen));
+    if (store == Co_NULL) {
+        gui_render_unlock();
+        return GUI_E_ERROR;
+    }
+
+    gui_memset(store, 0, sizeof(graphic_driver_t));
+    store->pixel_format = format;
+    store->width        = w;
+    store->height       = h;
+    store->pitch        = w * GUI_FB_BPP(store);
+    store->ops          = gui_framebuffer_get_ops(format);
+
+    win->store = store;
+    win->store_valid = 0;
+    _gui_window_locate_store(win);
+
+    /* fill the store with whole window */
+    gui_region_add_rect(&win->dirty, &win->extent);
+    _gui_window_commit(win);
+
+    gui_render_unlock();
+
+    return GUI_E_OK;
+}
+
 window_t *gui_get_main_window(void)
 {
     return main_page;
@@ -483,13 +1518,13 @@ void gui_assert_failed_page(const char* ex, uint16_t line, const char* func)
     widget->gc.padding = GUI_PADDING(17, 0, 5, 0);
 
     /* set to error code */
-    gui_widget_set_text(widget, ":("); 
+    gui_widget_set_static_text(widget, ":(");
     gui_widget_show(widget);
 
     widget = gui_widget_create(main_page);
     gui_widget_set_rectangle(widget, 20 , 120, 200, 200);
     gui_widget_set_font(widget, &tm_font_11x18);
-    gui_widget_set_text(widget, "Your computer ran into a problem.\n"); 
+    gui_widget_set_static_text(widget, "Your computer ran into a problem.\n");
     gui_widget_show(widget);
 
     widget = gui_widget_create(main_page);
@@ -499,7 +1534,7 @@ void gui_assert_failed_page(const char* ex, uint16_t line, const char* func)
     char l_str[10];
     gui_itoa(line, l_str);
 
-    gui_widget_set_text(widget, "Assert failed at\n"); 
+    gui_widget_set_static_text(widget, "Assert failed at\n");
     gui_widget_append_text(widget, f_str);
     gui_widget_append_text(widget, "\nLine: ");
     gui_widget_append_text(widget, l_str);
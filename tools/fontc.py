@@ -0,0 +1,357 @@
+#!/usr/bin/env python3
+"""
+Font compiler for GUI engine.
+
+Converts BDF fonts, or pre-rasterized tables in the style of
+tm_stm32f4_fonts.c (one uint16_t a row, ascii from space), into the packed
+font format of font.h: bit-packed or run length coded glyph bitmaps with a
+sorted codepoint range index. Only the codepoints asked for are kept.
+
+With --bpp 2 or 4 the font is anti-aliased: source glyphs --scale times
+larger than wanted are reduced, and the coverage of every pixel is kept.
+
+    fontc.py font.bdf --name font_12 --range 0x20-0x7E,0xC0-0xFF -o font_12.c
+    fontc.py src/tm_stm32f4_fonts.c --table tm_font7x10 --size 7x10 \\
+             --name font_7x10 --text strings.txt --rle -o font_7x10.c
+    fontc.py font_24.bdf --name font_12_aa --scale 2 --bpp 4 -o font_12_aa.c
+
+A size report of flash and RAM taken by the font is printed to stderr.
+"""
+
+import argparse
+import re
+import sys
+
+MAX_WIDTH = 16              # draw_glyph takes one word a row
+MAX_HEIGHT = 32             # GUI_FONT_MAX_HEIGHT in font.h
+GLYPH_RLE = 0x01            # GUI_GLYPH_RLE in font.h
+GLYPH_NONE = 0xFFFF         # GUI_GLYPH_NONE in font.h
+
+# sizes of structs in font.h on 32-bit target
+SIZEOF_GLYPH = 8            # struct font_packed_glyph
+SIZEOF_RANGE = 8            # struct font_range
+SIZEOF_PACKED = 20          # struct font_packed
+SIZEOF_FONT = 32            # font_t
+
+
+class Glyph:
+    """One glyph, rows are lists of pixel values, height rows of width."""
+
+    def __init__(self, code, width, advance, rows):
+        self.code = code
+        self.width = width
+        self.advance = advance
+        self.rows = rows
+
+
+def fail(msg):
+    sys.exit("fontc: " + msg)
+
+
+def load_bdf(path):
+    """Load BDF font, glyphs are placed on one baseline in a cell."""
+    glyphs = {}
+    ascent = descent = None
+    bbox = None
+
+    with open(path, encoding="latin-1") as f:
+        lines = iter(f.read().splitlines())
+
+    for line in lines:
+        key, _, arg = line.partition(" ")
+        if key == "FONTBOUNDINGBOX":
+            bbox = [int(v) for v in arg.split()]
+        elif key == "FONT_ASCENT":
+            ascent = int(arg)
+        elif key == "FONT_DESCENT":
+            descent = int(arg)
+        elif key == "STARTCHAR":
+            code, dwidth, bbx, bitmap = -1, None, None, []
+            for line in lines:
+                key, _, arg = line.partition(" ")
+                if key == "ENCODING":
+                    code = int(arg.split()[0])
+                elif key == "DWIDTH":
+                    dwidth = int(arg.split()[0])
+                elif key == "BBX":
+                    bbx = [int(v) for v in arg.split()]
+                elif key == "BITMAP":
+                    for line in lines:
+                        if line.startswith("ENDCHAR"):
+                            break
+                        bitmap.append(line.strip())
+                    break
+            if code >= 0 and bbx is not None:
+                glyphs[code] = (dwidth, bbx, bitmap)
+
+    if bbox is None:
+        fail("%s: no FONTBOUNDINGBOX" % path)
+    if ascent is None or descent is None:
+        ascent, descent = bbox[1] + bbox[3], -bbox[3]
+
+    height = ascent + descent
+    result = {}
+    for code, (dwidth, (bw, bh, xoff, yoff), bitmap) in glyphs.items():
+        # glyph starts at pen, so left bearing becomes blank columns
+        xoff = max(xoff, 0)
+        width = xoff + bw if bw else 0
+        rows = [[0] * width for _ in range(height)]
+        top = ascent - (yoff + bh)
+        for i, hexrow in enumerate(bitmap[:bh]):
+            bits = int(hexrow, 16) if hexrow else 0
+            nbits = len(hexrow) * 4
+            y = top + i
+            if not 0 <= y < height:
+                continue
+            for x in range(bw):
+                if bits >> (nbits - 1 - x) & 1:
+                    rows[y][xoff + x] = 1
+        advance = dwidth if dwidth is not None else width
+        result[code] = Glyph(code, width, advance, rows)
+
+    return result, height
+
+
+def load_table(path, name, size):
+    """Load a C table of one uint16_t a row, first glyph is space."""
+    width, height = (int(v) for v in size.lower().split("x"))
+
+    with open(path, encoding="latin-1") as f:
+        text = f.read()
+
+    m = re.search(r"\b%s\s*\[\s*\]\s*=\s*\{(.*?)\};" % re.escape(name), text, re.S)
+    if m is None:
+        fail("%s: no table %s" % (path, name))
+
+    body = re.sub(r"//[^\n]*|/\*.*?\*/", "", m.group(1), flags=re.S)
+    words = [int(v, 0) for v in re.findall(r"0[xX][0-9a-fA-F]+|\d+", body)]
+    if len(words) % height:
+        fail("%s: %d words is not a multiple of height %d" % (name, len(words), height))
+
+    result = {}
+    for g in range(len(words) // height):
+        rows = [[(w >> (15 - x)) & 1 for x in range(width)]
+                for w in words[g * height:(g + 1) * height]]
+        result[32 + g] = Glyph(32 + g, width, width, rows)
+
+    return result, height
+
+
+def parse_ranges(spec):
+    codes = set()
+    for part in filter(None, spec.split(",")):
+        lo, _, hi = part.partition("-")
+        lo = int(lo, 0)
+        hi = int(hi, 0) if hi else lo
+        codes.update(range(lo, hi + 1))
+    return codes
+
+
+def reduce(glyph, height, scale, bpp):
+    """Scale glyph down, pixel value is coverage of scale x scale source."""
+    levels = (1 << bpp) - 1
+    width = (glyph.width + scale - 1) // scale
+    rows = []
+    for y in range(height):
+        row = []
+        for x in range(width):
+            ink = sum(glyph.rows[sy][sx]
+                      for sy in range(y * scale, min((y + 1) * scale, len(glyph.rows)))
+                      for sx in range(x * scale, min((x + 1) * scale, glyph.width)))
+            row.append((ink * levels * 2 + scale * scale) // (scale * scale * 2))
+        rows.append(row)
+    glyph.rows = rows
+    glyph.width = width
+    glyph.advance = (glyph.advance * 2 + scale) // (scale * 2)
+
+
+def trim(glyph):
+    """Drop blank columns on the right, pen moves by advance anyway."""
+    while glyph.width and not any(r[glyph.width - 1] for r in glyph.rows):
+        glyph.width -= 1
+    glyph.rows = [r[:glyph.width] for r in glyph.rows]
+
+
+def pack_bits(glyph, bpp):
+    pixels = [p for r in glyph.rows for p in r]
+    out = bytearray((len(pixels) * bpp + 7) // 8)
+    for i, p in enumerate(pixels):
+        pos = i * bpp
+        out[pos >> 3] |= p << (8 - bpp - (pos & 7))
+    return bytes(out)
+
+
+def pack_rle(glyph):
+    out = bytearray()
+    run, cur = 0, None
+    for p in (p for r in glyph.rows for p in r):
+        if p == cur and run < 128:
+            run += 1
+            continue
+        if cur is not None:
+            out.append(cur << 7 | (run - 1))
+        cur, run = p, 1
+    if cur is not None:
+        out.append(cur << 7 | (run - 1))
+    return bytes(out)
+
+
+def make_ranges(codes):
+    """Consecutive codepoints share one range entry."""
+    ranges = []
+    for i, code in enumerate(codes):
+        if ranges and code == ranges[-1][0] + ranges[-1][1] and ranges[-1][1] < 0xFFFF:
+            ranges[-1][1] += 1
+        else:
+            ranges.append([code, 1, i])
+    return ranges
+
+
+def emit(out, name, source, glyphs, height, ranges, bitmap, missing, bpp):
+    w = out.write
+    max_advance = max((g.advance for g in glyphs), default=0)
+
+    w("/**\n")
+    w(" *" + "*" * 78 + "\n")
+    w(" * @file       %s.c\n" % name)
+    w(" * @version    V0.7.4\n")
+    w(" * @date       2020.04.18\n")
+    w(" * @brief      Packed font generated by tools/fontc.py from %s.\n" % source)
+    w(" *" + "*" * 78 + "\n")
+    w(" */\n\n")
+    w('#include "cogui.h"\n\n')
+
+    w("static const uint8_t %s_bitmap[] = {\n" % name)
+    for i in range(0, len(bitmap), 16):
+        w("    " + ",".join("0x%02X" % b for b in bitmap[i:i + 16]) + ",\n")
+    w("};\n\n")
+
+    w("static const struct font_packed_glyph %s_glyphs[] = {\n" % name)
+    for g in glyphs:
+        w("    {%6d, %2d, %2d, %d},     // U+%04X\n" % (g.offset, g.width, g.advance, g.flag, g.code))
+    w("};\n\n")
+
+    w("static const struct font_range %s_ranges[] = {\n" % name)
+    for first, count, index in ranges:
+        w("    {0x%04X, %4d, %4d},\n" % (first, count, index))
+    w("};\n\n")
+
+    w("static const struct font_packed %s_packed = {\n" % name)
+    w("    %s_ranges,\n" % name)
+    w("    sizeof(%s_ranges) / sizeof(%s_ranges[0]),\n" % (name, name))
+    w("    0x%04X,\n" % missing)
+    w("    %s_glyphs,\n" % name)
+    w("    %s_bitmap,\n" % name)
+    w("    %d\n" % bpp)
+    w("};\n\n")
+
+    w("font_t %s = {\n" % name)
+    w('    "%s",\n' % name)
+    w("    %d,\n" % max_advance)
+    w("    %d,\n" % height)
+    w("    Co_NULL,\n")
+    w("    Co_NULL,\n")
+    w("    Co_NULL,\n")
+    w("    0,\n")
+    w("    &%s_packed\n" % name)
+    w("};\n")
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Compile bitmap font to packed C table.")
+    ap.add_argument("input", help="BDF font, or C source with --table")
+    ap.add_argument("--table", help="name of uint16_t table in C source")
+    ap.add_argument("--size", help="WxH of C table glyphs")
+    ap.add_argument("--name", required=True, help="name of font_t in output")
+    ap.add_argument("--range", default="", help="codepoints to keep, e.g. 0x20-0x7E,0xE9")
+    ap.add_argument("--text", action="append", default=[], help="utf-8 file, keep codepoints it uses")
+    ap.add_argument("--missing", default="0x3F", help="codepoint drawn for unknown ones, 'none' to skip")
+    ap.add_argument("--rle", action="store_true", help="run length code glyphs where smaller")
+    ap.add_argument("--bpp", type=int, default=1, choices=(1, 2, 4), help="bits a pixel, 2 or 4 anti-aliased")
+    ap.add_argument("--scale", type=int, default=1, help="source is this many times larger")
+    ap.add_argument("-o", "--output", help="output C file, stdout if not given")
+    args = ap.parse_args()
+
+    if args.table:
+        if not args.size:
+            fail("--table needs --size")
+        font, height = load_table(args.input, args.table, args.size)
+    else:
+        font, height = load_bdf(args.input)
+
+    if args.rle and args.bpp > 1:
+        fail("--rle is for 1 bpp only")
+    if args.scale > 1 or args.bpp > 1:
+        for g in font.values():
+            reduce(g, (height + args.scale - 1) // args.scale, args.scale, args.bpp)
+        height = (height + args.scale - 1) // args.scale
+
+    if height > MAX_HEIGHT:
+        fail("height %d is over %d" % (height, MAX_HEIGHT))
+
+    wanted = parse_ranges(args.range)
+    for path in args.text:
+        with open(path, encoding="utf-8") as f:
+            wanted.update(ord(c) for c in f.read() if ord(c) >= 0x20)
+
+    missing = None if args.missing == "none" else int(args.missing, 0)
+    if missing is not None:
+        wanted.add(missing)
+    if not wanted:
+        wanted = set(font)
+
+    absent = sorted(c for c in wanted if c not in font)
+    codes = sorted(c for c in wanted if c in font)
+    if not codes:
+        fail("no glyph left")
+    if len(codes) >= GLYPH_NONE:
+        fail("too many glyphs")
+
+    glyphs = [font[c] for c in codes]
+    bitmap = bytearray()
+    rle_cnt = 0
+    for g in glyphs:
+        trim(g)
+        if g.width > MAX_WIDTH:
+            fail("U+%04X is %d wide, %d at most" % (g.code, g.width, MAX_WIDTH))
+        data, g.flag = pack_bits(g, args.bpp), 0
+        if args.rle:
+            rle = pack_rle(g)
+            if len(rle) < len(data):
+                data, g.flag = rle, GLYPH_RLE
+                rle_cnt += 1
+        g.offset = len(bitmap)
+        bitmap += data
+
+    # bit-packed rows read up to two bytes past glyph end
+    bitmap += bytes(2)
+
+    ranges = make_ranges(codes)
+    missing_index = codes.index(missing) if missing in font else GLYPH_NONE
+
+    out = open(args.output, "w", newline="\r\n") if args.output else sys.stdout
+    emit(out, args.name, args.input.replace("\\", "/").split("/")[-1],
+         glyphs, height, ranges, bitmap, missing_index, args.bpp)
+    if args.output:
+        out.close()
+
+    flash = (len(bitmap) + len(glyphs) * SIZEOF_GLYPH +
+             len(ranges) * SIZEOF_RANGE + SIZEOF_PACKED)
+    dense = (max(codes) - 32 + 1) * height * 2
+    r = sys.stderr.write
+    r("%s: %d glyphs in %d ranges, %dx%d cell, %d bpp, %d run length coded\n" %
+      (args.name, len(glyphs), len(ranges), max(g.advance for g in glyphs), height, args.bpp, rle_cnt))
+    r("  flash  %6d bytes (bitmap %d, glyphs %d, ranges %d, font %d)\n" %
+      (flash, len(bitmap), len(glyphs) * SIZEOF_GLYPH, len(ranges) * SIZEOF_RANGE, SIZEOF_PACKED))
+    if args.bpp > 1:
+        r("  ram    %6d bytes (font_t), glyph cache of engine while drawing\n" % SIZEOF_FONT)
+    else:
+        r("  ram    %6d bytes (font_t), %d bytes stack while drawing\n" % (SIZEOF_FONT, height * 2))
+    r("  dense  %6d bytes as one uint16_t a row from space\n" % dense)
+    if absent:
+        r("  %d codepoints not in font: %s\n" %
+          (len(absent), " ".join("U+%04X" % c for c in absent[:16]) + (" ..." if len(absent) > 16 else "")))
+
+
+if __name__ == "__main__":
+    main()
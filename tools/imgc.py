@@ -0,0 +1,407 @@
+#!/usr/bin/env python3
+"""
+Image compiler for GUI engine.
+
+Converts PNG or binary PPM pictures into image tables of image.h. Pictures
+with few colors are kept as palette indexes, 1, 4 or 8 bits a pixel, and
+others as RGB565 or ARGB8888 pixels. With --rle every image is run length
+coded where it gets smaller. Transparent pixels, or pixels of --key color,
+are left out when drawing.
+
+Large pictures can be kept as QOI or PNG files instead, decoded a row at a
+time while drawing. PNG is written with a zlib window of 2^--window bytes,
+which is the RAM it takes to draw besides two rows.
+
+A sheet of same size pictures is cut by --tile into an array of images
+sharing one palette, left to right and then top to bottom.
+
+    imgc.py logo.png --name logo --rle -o logo.c
+    imgc.py photo.ppm --name photo --format rgb565 -o photo.c
+    imgc.py splash.png --name splash --format png --window 10 -o splash.c
+    imgc.py app_icons.png --tile 60x60 --name gui_app_icons --rle -o app_icons.c
+
+A size report of flash taken by the images is printed to stderr.
+"""
+
+import argparse
+import struct
+import sys
+import zlib
+
+FORMATS = ["rgb565", "argb8888", "index1", "index4", "index8", "qoi", "png"]
+BITS = [16, 32, 1, 4, 8, 8, 8]
+FILE_FORMATS = (5, 6)
+IMAGE_RLE = 0x01            # GUI_IMAGE_RLE in image.h
+IMAGE_KEY = 0x02            # GUI_IMAGE_KEY in image.h
+
+# sizes of structs in image.h on 32-bit target
+SIZEOF_IMAGE = 24           # image_t
+SIZEOF_COLOR = 8            # color_t
+
+
+def fail(msg):
+    sys.exit("imgc: " + msg)
+
+
+def load_png(path):
+    """Load non-interlaced PNG of 8 bits a channel or palette, as RGBA rows."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        fail("%s is not PNG" % path)
+
+    pos, idat, plte, trns = 8, b"", b"", b""
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        if kind == b"IHDR":
+            width, height, depth, ctype, _, _, interlace = struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            plte = body
+        elif kind == b"tRNS":
+            trns = body
+        elif kind == b"IDAT":
+            idat += body
+        pos += 12 + length
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}.get(ctype)
+    if channels is None or interlace or (depth != 8 and ctype != 3):
+        fail("%s: only non-interlaced PNG of 8 bits a channel or palette" % path)
+
+    raw = zlib.decompress(idat)
+    stride = (width * channels * depth + 7) // 8
+    bpp = max(1, channels * depth // 8)
+    rows, prev, pos = [], bytearray(stride), 0
+    for _ in range(height):
+        kind, line = raw[pos], bytearray(raw[pos + 1:pos + 1 + stride])
+        pos += 1 + stride
+        for i in range(stride):
+            a = line[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            if kind == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif kind == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif kind == 3:
+                line[i] = (line[i] + (a + b) // 2) & 0xFF
+            elif kind == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                line[i] = (line[i] + (a if pa <= pb and pa <= pc else b if pb <= pc else c)) & 0xFF
+        prev = line
+
+        row = []
+        for x in range(width):
+            if ctype == 3:
+                bit = x * depth
+                v = (line[bit >> 3] >> (8 - depth - (bit & 7))) & ((1 << depth) - 1)
+                alpha = trns[v] if v < len(trns) else 255
+                row.append(tuple(plte[v * 3:v * 3 + 3]) + (alpha,))
+            elif ctype == 0:
+                row.append((line[x],) * 3 + (255,))
+            elif ctype == 4:
+                row.append((line[x * 2],) * 3 + (line[x * 2 + 1],))
+            elif ctype == 2:
+                row.append(tuple(line[x * 3:x * 3 + 3]) + (255,))
+            else:
+                row.append(tuple(line[x * 4:x * 4 + 4]))
+        rows.append(row)
+    return width, height, rows
+
+
+def load_ppm(path):
+    """Load binary PPM (P6) of 8 bits a channel."""
+    with open(path, "rb") as f:
+        data = f.read()
+    fields, pos = [], 0
+    while len(fields) < 4:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b"#":
+            pos = data.index(b"\n", pos)
+            continue
+        end = pos
+        while not data[end:end + 1].isspace():
+            end += 1
+        fields.append(data[pos:end])
+        pos = end
+    if fields[0] != b"P6" or int(fields[3]) != 255:
+        fail("%s: only binary PPM of 8 bits a channel" % path)
+    width, height = int(fields[1]), int(fields[2])
+    pix = data[pos + 1:]
+    return width, height, [[tuple(pix[(y * width + x) * 3:(y * width + x) * 3 + 3]) + (255,)
+                            for x in range(width)] for y in range(height)]
+
+
+def rgb565(c):
+    return (c[0] >> 3) << 11 | (c[1] >> 2) << 5 | c[2] >> 3
+
+
+def pack_rle(units, size):
+    """Runs of one byte header, high bit set repeats one unit."""
+    out = bytearray()
+    i, lit = 0, []
+
+    def flush():
+        while lit:
+            part = lit[:128]
+            del lit[:128]
+            out.append(len(part) - 1)
+            for v in part:
+                out.extend(v.to_bytes(size, "little"))
+
+    while i < len(units):
+        n = 1
+        while i + n < len(units) and units[i + n] == units[i] and n < 128:
+            n += 1
+        if n >= 3 or (n == 2 and not lit):
+            flush()
+            out.append(0x80 | (n - 1))
+            out.extend(units[i].to_bytes(size, "little"))
+            i += n
+        else:
+            lit.append(units[i])
+            i += 1
+    flush()
+    return bytes(out)
+
+
+def pack_plain(rows, bits):
+    """Rows of indexes packed highest bit first, or pixels, each row on a byte."""
+    out = bytearray()
+    for row in rows:
+        if bits >= 8:
+            for v in row:
+                out.extend(v.to_bytes(bits // 8, "little"))
+            continue
+        line = bytearray((len(row) * bits + 7) // 8)
+        for x, v in enumerate(row):
+            line[(x * bits) >> 3] |= v << (8 - bits - ((x * bits) & 7))
+        out.extend(line)
+    return bytes(out)
+
+
+def encode_qoi(rows):
+    """QOI file of RGBA rows."""
+    out = bytearray(b"qoif" + struct.pack(">IIBB", len(rows[0]), len(rows), 4, 0))
+    index = [(0, 0, 0, 0)] * 64
+    prev, run = (0, 0, 0, 255), 0
+    pixels = [p for row in rows for p in row]
+    for i, p in enumerate(pixels):
+        if p == prev:
+            run += 1
+            if run == 62 or i == len(pixels) - 1:
+                out.append(0xC0 | (run - 1))
+                run = 0
+            continue
+        if run:
+            out.append(0xC0 | (run - 1))
+            run = 0
+        h = (p[0] * 3 + p[1] * 5 + p[2] * 7 + p[3] * 11) % 64
+        if index[h] == p:
+            out.append(h)
+        elif p[3] != prev[3]:
+            out += bytes((0xFF,) + p)
+        else:
+            dr, dg, db = ((p[k] - prev[k] + 128) % 256 - 128 for k in range(3))
+            if -2 <= dr <= 1 and -2 <= dg <= 1 and -2 <= db <= 1:
+                out.append(0x40 | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2))
+            elif -32 <= dg <= 31 and -8 <= dr - dg <= 7 and -8 <= db - dg <= 7:
+                out += bytes((0x80 | (dg + 32), (dr - dg + 8) << 4 | (db - dg + 8)))
+            else:
+                out += bytes((0xFE,) + p[:3])
+        index[h] = p
+        prev = p
+    return bytes(out + bytes(7) + b"\x01")
+
+
+def encode_png(rows, wbits):
+    """PNG file of RGBA rows, palette if colors are few, window of 2^wbits bytes."""
+    def chunk(kind, body):
+        return struct.pack(">I", len(body)) + kind + body + struct.pack(">I", zlib.crc32(kind + body))
+
+    width, colors = len(rows[0]), sorted(set(p for row in rows for p in row))
+    opaque = all(p[3] == 255 for p in colors)
+    extra = b""
+    if len(colors) <= 256:
+        depth = next(d for d in (1, 2, 4, 8) if len(colors) <= 1 << d)
+        index = {c: i for i, c in enumerate(colors)}
+        ctype, bpp = 3, 1
+        extra = chunk(b"PLTE", bytes(v for c in colors for v in c[:3]))
+        if not opaque:
+            extra += chunk(b"tRNS", bytes(c[3] for c in colors))
+        lines = [pack_plain([[index[p] for p in row]], depth) for row in rows]
+    else:
+        depth, ctype, bpp = 8, 2 if opaque else 6, 3 if opaque else 4
+        lines = [bytes(v for p in row for v in p[:bpp]) for row in rows]
+
+    # filter of least sum, as most encoders guess
+    raw, prev = bytearray(), bytes(len(lines[0]))
+    for line in lines:
+        best = None
+        for kind in range(5):
+            out = bytearray(len(line))
+            for k in range(len(line)):
+                a = line[k - bpp] if k >= bpp else 0
+                b = prev[k]
+                c = prev[k - bpp] if k >= bpp else 0
+                if kind == 4:
+                    p = a + b - c
+                    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                    pred = a if pa <= pb and pa <= pc else b if pb <= pc else c
+                else:
+                    pred = (0, a, b, (a + b) // 2)[kind]
+                out[k] = (line[k] - pred) & 0xFF
+            cost = sum(v if v < 128 else 256 - v for v in out)
+            if best is None or cost < best[0]:
+                best = (cost, kind, out)
+        raw += bytes((best[1],)) + best[2]
+        prev = line
+
+    z = zlib.compressobj(9, zlib.DEFLATED, wbits)
+    data = z.compress(bytes(raw)) + z.flush()
+    return (b"\x89PNG\r\n\x1a\n" + chunk(b"IHDR", struct.pack(">IIBBBBB", width, len(rows), depth, ctype, 0, 0, 0)) +
+            extra + chunk(b"IDAT", data) + chunk(b"IEND", b""))
+
+
+def emit(out, file, name, source, images, palette, fmt, array):
+    w = out.write
+
+    w("/**\n")
+    w(" *" + "*" * 78 + "\n")
+    w(" * @file       %s\n" % file)
+    w(" * @version    V0.7.4\n")
+    w(" * @date       2020.04.18\n")
+    w(" * @brief      Images generated by tools/imgc.py from %s.\n" % source)
+    w(" *" + "*" * 78 + "\n")
+    w(" */\n\n")
+    w('#include "cogui.h"\n\n')
+
+    if palette:
+        w("static const color_t %s_palette[] = {\n" % name)
+        for c in palette:
+            w("    GUI_RGB(0x%02X, 0x%02X, 0x%02X),\n" % c[:3])
+        w("};\n\n")
+
+    # plain pixels are kept aligned to their size
+    for i, img in enumerate(images):
+        size = 1 if img["flag"] & IMAGE_RLE or BITS[fmt] < 16 else BITS[fmt] // 8
+        data = img["data"]
+        w("static const %s %s_data%d[] = {\n" % (("uint8_t", "uint16_t", "", "uint32_t")[size - 1], name, i))
+        values = [int.from_bytes(data[k:k + size], "little") for k in range(0, len(data), size)]
+        per = 16 // size
+        for k in range(0, len(values), per):
+            w("    " + ",".join("0x%0*X" % (size * 2, v) for v in values[k:k + per]) + ",\n")
+        w("};\n\n")
+
+    fields = []
+    for i, img in enumerate(images):
+        flag = " | ".join(s for b, s in ((IMAGE_RLE, "GUI_IMAGE_RLE"), (IMAGE_KEY, "GUI_IMAGE_KEY"))
+                          if img["flag"] & b) or "0"
+        fields.append(["GUI_IMAGE_" + FORMATS[fmt].upper(), flag, "%d" % img["width"], "%d" % img["height"],
+                       "0x%X" % img["key"], name + "_palette" if palette else "Co_NULL",
+                       "(const uint8_t *)%s_data%d" % (name, i), "0"])
+        if fmt in FILE_FORMATS:
+            fields[-1][-2] = "%s_data%d" % (name, i)
+            fields[-1][-1] = "sizeof(%s_data%d)" % (name, i)
+
+    if array:
+        w("const image_t %s[] = {\n" % name)
+        for f in fields:
+            w("    {" + ", ".join(f) + "},\n")
+    else:
+        w("const image_t %s = {\n" % name)
+        w(",\n".join("    " + v for v in fields[0]) + "\n")
+    w("};\n")
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Compile pictures to C image tables.")
+    ap.add_argument("input", help="PNG or binary PPM picture")
+    ap.add_argument("--name", required=True, help="name of image_t in output")
+    ap.add_argument("--format", default="auto", choices=["auto"] + FORMATS, help="pixel format of images")
+    ap.add_argument("--tile", help="WxH, cut picture into an array of images")
+    ap.add_argument("--key", help="RRGGBB color not drawn, besides transparent pixels")
+    ap.add_argument("--rle", action="store_true", help="run length code images where smaller")
+    ap.add_argument("--window", type=int, default=15, choices=range(9, 16), help="zlib window bits of png")
+    ap.add_argument("-o", "--output", help="output C file, stdout if not given")
+    args = ap.parse_args()
+
+    if args.input.lower().endswith(".png"):
+        width, height, rows = load_png(args.input)
+    else:
+        width, height, rows = load_ppm(args.input)
+
+    tw, th = (int(v) for v in args.tile.lower().split("x")) if args.tile else (width, height)
+    if width % tw or height % th:
+        fail("%dx%d picture is not cut into %dx%d tiles" % (width, height, tw, th))
+
+    key = tuple(int(args.key[i:i + 2], 16) for i in (0, 2, 4)) if args.key else None
+    pixels = [[None if p[3] < 128 or p[:3] == key else p[:3] for p in row] for row in rows]
+    keyed = any(p is None for row in pixels for p in row)
+
+    colors = sorted(set(p for row in pixels for p in row if p is not None))
+    fmt = FORMATS.index(args.format) if args.format != "auto" else None
+
+    count = len(colors) + keyed
+    if fmt is None:
+        fmt = next((f for f in (2, 3, 4) if count <= 1 << BITS[f]), 0)
+    if 2 <= fmt <= 4 and count > 1 << BITS[fmt]:
+        fail("%d colors do not fit %s" % (count, FORMATS[fmt]))
+
+    # key is index 0, or a pixel not used by picture
+    palette, key_value = [], 0
+    if fmt in FILE_FORMATS:
+        # files keep alpha, key color is made transparent
+        value = lambda p: (0, 0, 0, 0) if p[:3] == key else tuple(p)
+        pixels, keyed = rows, False
+    elif fmt >= 2:
+        palette = ([(0, 0, 0)] if keyed else []) + colors
+        index = {c: i for i, c in enumerate(palette) if not (keyed and i == 0)}
+        value = lambda p: 0 if p is None else index[p]
+    else:
+        used = set(rgb565(c) if fmt == 0 else 0xFF000000 | c[0] << 16 | c[1] << 8 | c[2] for c in colors)
+        key_value = next(v for v in ((0xF81F, 0x0001, 0x0020) if fmt == 0 else
+                                     (0xFFFF00FF, 0xFF000001, 0xFF000100)) if v not in used)
+        if fmt == 0:
+            value = lambda p: key_value if p is None else rgb565(p)
+        else:
+            value = lambda p: key_value if p is None else 0xFF000000 | p[0] << 16 | p[1] << 8 | p[2]
+
+    images = []
+    for ty in range(0, height, th):
+        for tx in range(0, width, tw):
+            tile = [[value(p) for p in row[tx:tx + tw]] for row in pixels[ty:ty + th]]
+            img = {"width": tw, "height": th, "key": key_value if keyed else 0,
+                   "flag": IMAGE_KEY if keyed else 0}
+            if fmt in FILE_FORMATS:
+                img["data"] = encode_qoi(tile) if fmt == 5 else encode_png(tile, args.window)
+                images.append(img)
+                continue
+            img["data"] = pack_plain(tile, BITS[fmt])
+            if args.rle:
+                rle = pack_rle([v for row in tile for v in row], max(1, BITS[fmt] // 8))
+                if len(rle) < len(img["data"]):
+                    img["data"], img["flag"] = rle, img["flag"] | IMAGE_RLE
+            images.append(img)
+
+    out = open(args.output, "w", newline="\r\n") if args.output else sys.stdout
+    emit(out, (args.output or args.name + ".c").replace("\\", "/").split("/")[-1], args.name, args.input.replace("\\", "/").split("/")[-1],
+         images, palette, fmt, args.tile is not None)
+    if args.output:
+        out.close()
+
+    data = sum(len(img["data"]) for img in images)
+    flash = data + len(palette) * SIZEOF_COLOR + len(images) * SIZEOF_IMAGE
+    r = sys.stderr.write
+    r("%s: %d image(s) of %dx%d, %s, %d colors%s, %d run length coded\n" %
+      (args.name, len(images), tw, th, FORMATS[fmt], len(colors), " and key" if keyed else "",
+       sum(1 for img in images if img["flag"] & IMAGE_RLE)))
+    r("  flash  %6d bytes (data %d, palette %d, images %d)\n" %
+      (flash, data, len(palette) * SIZEOF_COLOR, len(images) * SIZEOF_IMAGE))
+    r("  rgb565 %6d bytes as plain pixels\n" % (width * height * 2))
+
+
+if __name__ == "__main__":
+    main()